@@ -0,0 +1,60 @@
+#include <algorithm> // std::max
+#include "AssetRegistry.h"
+
+AssetRegistry::AssetRegistry() {
+    sf::Image images[NUM_ASSETS];
+    // Shelf packing: fill a row up to ATLAS_WIDTH, then start a new row under the tallest image so far
+    unsigned shelfLeft = 0;
+    unsigned shelfTop = 0;
+    unsigned shelfHeight = 0;
+    for (int i = 0; i < NUM_ASSETS; i++) {
+        if (!images[i].loadFromFile(getFileName(i))) {
+            throw file_read_exception("Textures were missing from directory files/images!");
+        }
+        sf::Vector2u size = images[i].getSize();
+        if (shelfLeft + size.x > ATLAS_WIDTH) {
+            shelfTop += shelfHeight;
+            shelfLeft = 0;
+            shelfHeight = 0;
+        }
+        regions[i] = sf::IntRect(static_cast<int>(shelfLeft), static_cast<int>(shelfTop),
+                                 static_cast<int>(size.x), static_cast<int>(size.y));
+        shelfLeft += size.x;
+        shelfHeight = std::max(shelfHeight, size.y);
+    }
+
+    atlasImage.create(ATLAS_WIDTH, shelfTop + shelfHeight, sf::Color::Transparent);
+    for (int i = 0; i < NUM_ASSETS; i++) {
+        atlasImage.copy(images[i], static_cast<unsigned>(regions[i].left), static_cast<unsigned>(regions[i].top));
+    }
+    atlas.loadFromImage(atlasImage);
+}
+
+const char* AssetRegistry::getFileName(int asset) {
+    static const char* fileNames[NUM_ASSETS] = {
+            "files/images/flag.png", "files/images/number_1.png", "files/images/number_2.png",
+            "files/images/number_3.png", "files/images/number_4.png", "files/images/number_5.png",
+            "files/images/number_6.png", "files/images/number_7.png", "files/images/number_8.png",
+            "files/images/mine.png", "files/images/tile_hidden.png", "files/images/tile_revealed.png",
+            "files/images/debug.png", "files/images/digits.png", "files/images/face_happy.png",
+            "files/images/face_lose.png", "files/images/face_win.png", "files/images/leaderboard.png",
+            "files/images/pause.png", "files/images/play.png"
+    };
+    return fileNames[asset];
+}
+
+const sf::Texture& AssetRegistry::getTexture() const {
+    return this->atlas;
+}
+
+const sf::IntRect& AssetRegistry::getRegion(int asset) const {
+    return this->regions[asset];
+}
+
+sf::Sprite AssetRegistry::makeSprite(int asset) const {
+    return sf::Sprite(atlas, regions[asset]);
+}
+
+void AssetRegistry::copyToTexture(int asset, sf::Texture& texture) const {
+    texture.loadFromImage(atlasImage, regions[asset]);
+}
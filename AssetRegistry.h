@@ -0,0 +1,42 @@
+#ifndef MINESWEEPER_ASSET_REGISTRY_H
+#define MINESWEEPER_ASSET_REGISTRY_H
+
+#include <SFML/Graphics.hpp>
+#include "file_read_exception.h"
+
+// Loads every image once and packs them into a single atlas texture. Everything that draws
+// shares the one atlas and refers to images by region, so no texture is ever copied.
+class AssetRegistry {
+public:
+    // The one list of images; also the order they are packed in
+    enum assetIndices {
+        flag, num1, num2, num3, num4, num5, num6, num7, num8, mine, hidden, revealed,
+        debug, digits, happy, lose, win, lb, pause, play, NUM_ASSETS
+    };
+
+private:
+    // Atlas width; images are packed left to right in shelves
+    static const unsigned ATLAS_WIDTH = 512;
+
+    sf::Image atlasImage;
+    sf::Texture atlas;
+    sf::IntRect regions[NUM_ASSETS];
+
+    static const char* getFileName(int asset);
+
+public:
+    // Throws file_read_exception if an image is missing
+    AssetRegistry();
+
+    const sf::Texture& getTexture() const;
+
+    const sf::IntRect& getRegion(int asset) const;
+
+    // Sprite drawing one image out of the shared atlas
+    sf::Sprite makeSprite(int asset) const;
+
+    // Standalone copy of one image, for the rare case that needs its own texture (e.g. repeating)
+    void copyToTexture(int asset, sf::Texture& texture) const;
+};
+
+#endif //MINESWEEPER_ASSET_REGISTRY_H
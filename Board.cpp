@@ -1,26 +1,34 @@
 #include "Board.h"
+#include "ReplayLog.h"
 
 
-Board::Board(std::pair<int, int> dimensions, int mineCount) {
+Board::Board(std::pair<int, int> dimensions, int mineCount, std::uint64_t seed) : mineSampler(seed) {
     this->dimensions = std::move(dimensions);
+    this->seed = seed;
     this->mineCount = mineCount;
     this->isDebug = false;
     this->gameOver = false;
     this->gameWon = false;
     this->isPaused = false;
+    this->recorder = nullptr;
+    this->revision = 0;
     initializeBoard();
 }
 
+Tile Board::getTile(int col, int row) {
+    return Tile(board, board.index(col, row));
+}
+
+const TileGrid& Board::getGrid() const {
+    return this->board;
+}
+
+void Board::clearDirty() {
+    board.clearDirty();
+}
+
 int Board::getFlags() const {
-    int numFlagged = 0;
-    for (const std::vector<Tile>& col: this->board) {
-        for (const Tile& tile: col) {
-            if (tile.isFlagged()) {
-                numFlagged++;
-            }
-        }
-    }
-    return numFlagged;
+    return board.countFlagged();
 }
 
 int Board::getMines() const {
@@ -28,15 +36,19 @@ int Board::getMines() const {
 }
 
 int Board::getRevealed() const {
-    int numRevealed = 0;
-    for (const std::vector<Tile>& column : this->board ) {
-        for (const Tile& tile : column) {
-            if (tile.isRevealed()) {
-                numRevealed++;
-            }
-        }
-    }
-    return numRevealed;
+    return board.countRevealed();
+}
+
+int Board::getSafeRemaining() const {
+    return board.countSafeRemaining();
+}
+
+std::uint64_t Board::getRevision() const {
+    return this->revision;
+}
+
+std::uint64_t Board::getSeed() const {
+    return this->seed;
 }
 
 bool Board::isDebugMode() const {
@@ -55,216 +67,157 @@ bool Board::isGameWon() const {
     return this->gameWon;
 }
 
-void Board::populateBoard() {
-    // Seed the random number generator and start generating
-    std::mt19937 rng(std::chrono::high_resolution_clock::now().time_since_epoch().count());
-    std::uniform_int_distribution<> randomCol(0, dimensions.first - 1);
-    std::uniform_int_distribution<> randomRow(0, dimensions.second - 1);
-    int minesRemaining;
-    // If the config asks for too many mines, just fill the board
-    if (mineCount >= dimensions.first * dimensions.second) {
-        minesRemaining = dimensions.first * dimensions.second;
-    } else {
-        minesRemaining = mineCount;
-    }
-    int colCoord;
-    int rowCoord;
-    while (minesRemaining != 0) {
-        // Re-roll if there's already a mine
-        colCoord = randomCol(rng);
-        rowCoord = randomRow(rng);
-        if (board[colCoord][rowCoord].isMine()) {
-            continue;
-        }
-        board[colCoord][rowCoord].setMine(true);
-        minesRemaining--;
-    }
+void Board::populateBoard(int safeIndex) {
+    // If the config asks for too many mines, the sampler just fills the board
+    mineSampler.placeMines(board, mineCount, safeIndex);
+    this->minesPlaced = true;
 }
 
 // Initialize an empty board
 void Board::initializeBoard() {
-    // Initialize the board with empty Tiles
-    for (int col = 0; col < dimensions.first; col++) {
-        std::vector<Tile> colVector;
-        for (int row = 0; row < dimensions.second; row++) {
-            std::pair<int, int> coords;
-            std::vector<Tile*> neighbors = {};
-            coords = {col, row};
-            Tile tile = Tile(coords, neighbors);
-            colVector.push_back(tile);
-        }
-        board.push_back(colVector);
-        colVector.clear();
-    }
-
-    for (int i = 0; i < dimensions.first; i++) {
-        for (int j = 0; j < dimensions.second; j++) {
-            std::vector<Tile*> neighbors = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
-            neighbors[TOP_LEFT] = (i > 0 && j > 0) ? &board[i - 1][j - 1] : nullptr;
-            neighbors[TOP_MID] = (j > 0) ? &board[i][j - 1] : nullptr;
-            neighbors[TOP_RIGHT] = (i < dimensions.first - 1 && j > 0) ? &board[i + 1][j - 1] : nullptr;
-            // Middle colVector
-            neighbors[MID_LEFT] = (i > 0) ? &board[i - 1][j] : nullptr;
-            neighbors[MID_RIGHT] = (i < dimensions.first - 1) ? &board[i + 1][j] : nullptr;
-            // Bottom colVector
-            neighbors[BOT_LEFT] = (i > 0 && j < dimensions.second - 1) ? &board[i - 1][j + 1] : nullptr;
-            neighbors[BOT_MID] = (j < dimensions.second - 1) ? &board[i][j + 1] : nullptr;
-            neighbors[BOT_RIGHT] = (i < dimensions.first - 1 && j < dimensions.second - 1)
-                                   ? &board[i + 1][j + 1] : nullptr;
-            board[i][j].setNeighbors(neighbors);
-        }
-    }
-    populateBoard();
-}
-
-// Figure out which tile was clicked
-Tile* Board::findTileClicked(const sf::RenderWindow& window, const sf::Vector2i& mousePosition) {
-    sf::Vector2f translatedPosition = window.mapPixelToCoords(mousePosition);
-    for (std::vector<Tile>& col: board) {
-        for (Tile& tile: col) {
-            if (tile.getSprite().getGlobalBounds().contains(translatedPosition)) {
-                return &tile;
-            }
-        }
-    }
-    // Click was not on any Tiles
-    return nullptr;
+    // One contiguous byte per tile; neighbors are computed from the index
+    board = TileGrid(dimensions.first, dimensions.second);
+    // Mines are placed on the first reveal
+    this->minesPlaced = false;
 }
 
 void Board::setDebug(bool debug) {
     this->isDebug = debug;
-    for (std::vector<Tile>& col: this->board) {
-        for (Tile& tile: col) {
-            tile.setDebug(debug);
-        }
-    }
+    // Debug mode changes how every mine is drawn
+    board.markAllDirty();
 }
 
 void Board::setPaused(bool p) {
+    if (isPaused == p) {
+        return;
+    }
     this->isPaused = p;
+    if (recorder != nullptr) {
+        recorder->record(p ? ReplayEvent::pause : ReplayEvent::resume, 0, 0, *this);
+    }
 }
 
 // Reset the board
 void Board::reset() {
-    for (std::vector<Tile>& vec: board) {
-        for (Tile& tile: vec) {
-            tile.reset();
-        }
-    }
-    populateBoard();
+    // Each new game gets the next seed, so a run of games is as reproducible as the first
+    reset(seed + 1);
+}
+
+void Board::reset(std::uint64_t gameSeed) {
+    board.clear();
+    this->minesPlaced = false;
+    this->seed = gameSeed;
+    mineSampler.reseed(seed);
     this->gameOver = false;
     this->gameWon = false;
+    this->revision++;
+    if (recorder != nullptr) {
+        recorder->record(ReplayEvent::reset, 0, 0, *this);
+    }
 }
 
-void Board::click(sf::RenderWindow& window, const sf::Vector2i& mousePosition, const bool& isLmb) {
-    if (paused()) {
+void Board::generate(int col, int row) {
+    if (minesPlaced || !board.inBounds(col, row)) {
         return;
     }
-    Tile* clickedTile = findTileClicked(window, mousePosition);
-    // Split in two statements to ensure isRevealed() is never called on a nullptr (short-circuit eval not guaranteed)
-    if (clickedTile == nullptr) {
+    populateBoard(board.index(col, row));
+}
+
+void Board::reveal(int col, int row) {
+    if (paused() || gameOver || !board.inBounds(col, row)) {
         return;
     }
-    // Move the mine if the first tile clicked is a mine
-    if (getRevealed() == 0 && clickedTile->isMine()) {
-        moveMine(*clickedTile);
-    }
-    if (clickedTile->isRevealed()) {
+    Tile clickedTile = getTile(col, row);
+    if (clickedTile.isRevealed() || clickedTile.isFlagged()) {
         return;
     }
-    if (isLmb) {
-        if (clickedTile->isFlagged()) {
-            return;
-        }
-        std::vector<Tile*> neighbors = clickedTile->getNeighbors();
-        recursiveReveal(*clickedTile);
-        if (clickedTile->isMine()) {
-            this->gameOver = true;
-            this->gameWon = false;
-            showMines();
-            return;
-        }
-        int numRevealed = this->getRevealed();
-        if (numRevealed == this->dimensions.first * this->dimensions.second - this->mineCount) {
-            this->gameOver = true;
-            this->gameWon = true;
-            showMines();
-
-            return;
-        }
-    } else {
-        clickedTile->setFlagged(!clickedTile->isFlagged());
-    }
-}
-
-void Board::moveMine(Tile& clickedTile) {
-    // If the board is full or full -1 for some reason, do nothing (avoid infinite loop and a guaranteed win).
-    if (mineCount - 1 >= dimensions.first * dimensions.second) {
-        return;
+    // The first reveal always opens a region
+    generate(col, row);
+    revealFrom(clickedTile);
+    if (clickedTile.isMine()) {
+        this->gameOver = true;
+        this->gameWon = false;
+        showMines();
+    } else if (getSafeRemaining() == 0) {
+        this->gameOver = true;
+        this->gameWon = true;
+        showMines();
     }
-    clickedTile.setMine(false);
-    std::mt19937 rng(std::chrono::high_resolution_clock::now().time_since_epoch().count());
-    std::uniform_int_distribution<> randomCol(0, dimensions.first - 1);
-    std::uniform_int_distribution<> randomRow(0, dimensions.second - 1);
-    int colCoord;
-    int rowCoord;
-    bool mineSet = false;
-    while (!mineSet) {
-        // Re-roll if there's already a mine
-        colCoord = randomCol(rng);
-        rowCoord = randomRow(rng);
-        if (board[colCoord][rowCoord].isMine()) {
-            continue;
-        } else {
-            board[colCoord][rowCoord].setMine(true);
-            mineSet = true;
-        }
+    this->revision++;
+    if (recorder != nullptr) {
+        recorder->record(ReplayEvent::reveal, col, row, *this);
     }
 }
 
-// Recursive, guaranteed to be fewer calls than the size of the board
-void Board::recursiveReveal(Tile& tile) {
-    if (tile.isMine() || tile.isFlagged()) {
+void Board::toggleFlag(int col, int row) {
+    if (paused() || gameOver || !board.inBounds(col, row)) {
         return;
     }
-    tile.setRevealed(true);
-    // Base case: Return early if there's a mine or flag next to me
-    if (tile.getNumMineNeighbors() != 0 || tile.getNumFlagNeighbors()) {
+    Tile clickedTile = getTile(col, row);
+    if (clickedTile.isRevealed()) {
         return;
     }
-
-    std::vector<Tile*> neighbors = tile.getNeighbors();
-
-    for (Tile* neighbor: neighbors) {
-        if (neighbor == nullptr) {
-            continue;
-        }
-        if (neighbor->isRevealed()) {
-            continue;
-        }
-        neighbor->setRevealed(true);
-        if (neighbor->getNumMineNeighbors() == 0) {
-            recursiveReveal(*neighbor);
-
-        }
+    clickedTile.setFlagged(!clickedTile.isFlagged());
+    this->revision++;
+    if (recorder != nullptr) {
+        recorder->record(ReplayEvent::flag, col, row, *this);
     }
 }
 
+// Flood-fill from the tile; returns the indices of every tile revealed
+const std::vector<int>& Board::revealFrom(Tile& tile) {
+    return revealEngine.reveal(board, tile.getIndex());
+}
+
 // Show all the mines
 void Board::showMines() {
-    for (std::vector<Tile>& column : this->board) {
-        for (Tile& tile : column) {
-            if (tile.isMine()) {
-                tile.setRevealed(true);
-            }
+    for (int i = 0; i < board.size(); i++) {
+        if (board.isMine(i)) {
+            board.setRevealed(i, true);
         }
     }
 }
 
-void Board::render(sf::RenderWindow& window, const std::vector<sf::Texture>& textures) {
-    for (auto& col: board) {
-        for (auto& tile: col) {
-            tile.render(window, textures, isPaused, gameOver, gameWon);
-        }
+bool BoardState::operator==(const BoardState& other) const {
+    return seed == other.seed && minesPlaced == other.minesPlaced && paused == other.paused &&
+           gameOver == other.gameOver && gameWon == other.gameWon && tiles == other.tiles;
+}
+
+BoardState Board::saveState() const {
+    BoardState state;
+    state.seed = seed;
+    state.minesPlaced = minesPlaced;
+    state.paused = isPaused;
+    state.gameOver = gameOver;
+    state.gameWon = gameWon;
+    state.tiles.resize(static_cast<size_t>(board.size()));
+    for (int i = 0; i < board.size(); i++) {
+        state.tiles[i] = static_cast<std::uint8_t>((board.isMine(i) ? BoardState::mineBit : 0) |
+                                                   (board.isRevealed(i) ? BoardState::revealedBit : 0) |
+                                                   (board.isFlagged(i) ? BoardState::flaggedBit : 0));
+    }
+    return state;
+}
+
+void Board::restoreState(const BoardState& state) {
+    board.clear();
+    for (int i = 0; i < board.size(); i++) {
+        std::uint8_t tile = state.tiles[i];
+        // setMine rebuilds the adjacency counts as it goes
+        board.setMine(i, (tile & BoardState::mineBit) != 0);
+        board.setRevealed(i, (tile & BoardState::revealedBit) != 0);
+        board.setFlagged(i, (tile & BoardState::flaggedBit) != 0);
     }
+    this->seed = state.seed;
+    // Mines not yet placed are generated from the seed, exactly as they would have been
+    mineSampler.reseed(seed);
+    this->minesPlaced = state.minesPlaced;
+    this->isPaused = state.paused;
+    this->gameOver = state.gameOver;
+    this->gameWon = state.gameWon;
+    this->revision++;
+}
+
+void Board::setRecorder(ReplayWriter* writer) {
+    this->recorder = writer;
 }
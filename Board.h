@@ -2,32 +2,62 @@
 #define MINESWEEPER_BOARD_H
 
 #include "Tile.h"
-#include <random> // random numbers for the mines
-#include <chrono> // random number seed
+#include "RevealEngine.h"
+#include "MineSampler.h"
+#include <cstdint> // Board seeds
+
+class ReplayWriter;
+
+// Everything needed to put a board back exactly as it was; used by replay keyframes
+struct BoardState {
+    enum tileBits {
+        mineBit = 1, revealedBit = 2, flaggedBit = 4
+    };
+    std::uint64_t seed;
+    bool minesPlaced;
+    bool paused;
+    bool gameOver;
+    bool gameWon;
+    // One byte of tileBits per tile, row-major
+    std::vector<std::uint8_t> tiles;
 
-enum pos {
-    TOP_LEFT, TOP_MID, TOP_RIGHT, MID_LEFT, MID_RIGHT, BOT_LEFT, BOT_MID, BOT_RIGHT
+    bool operator==(const BoardState& other) const;
 };
 
+// The game rules: generation, reveal, flagging, win/loss and counters. Has no SFML dependency.
 class Board {
 private:
     std::pair<int, int> dimensions;
-    std::vector<std::vector<Tile>> board;
+    TileGrid board;
+    RevealEngine revealEngine;
+    // Seed of the current game; the sampler is reseeded from it on every reset
+    std::uint64_t seed;
+    MineSampler mineSampler;
     int mineCount;
+    bool minesPlaced;
     bool isDebug;
     bool isPaused;
     bool gameWon;
     bool gameOver;
+    // Notified of every action that changes the game; null when not recording
+    ReplayWriter* recorder;
+    // Bumped by every action that changes a tile, so observers can tell when to look again
+    std::uint64_t revision;
 
     void initializeBoard();
 
-    void populateBoard();
+    // Keeps safeIndex and its neighbors clear of mines
+    void populateBoard(int safeIndex);
+
+public:
+    Board(std::pair<int, int> dimensions, int mineCount, std::uint64_t seed);
 
-    Tile* findTileClicked(const sf::RenderWindow& window, const sf::Vector2i& mousePosition);
+    Tile getTile(int col, int row);
 
+    const TileGrid& getGrid() const;
 
-public:
-    explicit Board(std::pair<int, int> dimensions, int mineCount);
+    // Called by the renderer once it has redrawn the dirty tiles
+    void clearDirty();
 
     int getFlags() const;
 
@@ -35,6 +65,12 @@ public:
 
     int getRevealed() const;
 
+    int getSafeRemaining() const;
+
+    std::uint64_t getRevision() const;
+
+    std::uint64_t getSeed() const;
+
     bool isDebugMode() const;
 
     bool paused() const;
@@ -47,17 +83,31 @@ public:
 
     void setPaused(bool p);
 
+    // A new game from the next seed
     void reset();
 
-    void click(sf::RenderWindow& window, const sf::Vector2i& mousePosition, const bool& isLmb);
+    // A new game from the given seed
+    void reset(std::uint64_t gameSeed);
+
+    // Places the mines now, keeping (col, row) and its neighbors clear. Does nothing once they are placed;
+    // reveal() calls it on the first reveal.
+    void generate(int col, int row);
 
-    void recursiveReveal(Tile& tile);
+    // Game rules only; no windowing. Both ignore off-board coordinates and do nothing while paused or over.
+    void reveal(int col, int row);
+
+    void toggleFlag(int col, int row);
+
+    const std::vector<int>& revealFrom(Tile& tile);
 
     void showMines();
 
-    void render(sf::RenderWindow& window, const std::vector<sf::Texture>& textures);
+    BoardState saveState() const;
+
+    // The state must come from a board with the same dimensions
+    void restoreState(const BoardState& state);
 
-    void moveMine(Tile& clickedTile);
+    void setRecorder(ReplayWriter* writer);
 };
 
 #endif //MINESWEEPER_BOARD_H
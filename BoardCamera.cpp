@@ -0,0 +1,57 @@
+#include <algorithm> // std::min and std::max for the zoom range
+#include "BoardCamera.h"
+
+namespace {
+    // Tiles are at most 64 pixels across, and at least 8: further out, a view of a huge board would
+    // cost as much to draw as the board itself
+    const float MIN_ZOOM = 0.5f;
+    const float MAX_ZOOM = 4;
+}
+
+BoardCamera::BoardCamera(const sf::Vector2u& windowSize, float trayHeight, const TileGrid& grid) {
+    this->areaSize = sf::Vector2f(static_cast<float>(windowSize.x), static_cast<float>(windowSize.y) - trayHeight);
+    this->boardSize = sf::Vector2f(static_cast<float>(grid.getCols() * 32), static_cast<float>(grid.getRows() * 32));
+    // No further out than it takes to show the whole board
+    this->maxZoom = std::min(MAX_ZOOM, std::max(1.0f, std::max(boardSize.x / areaSize.x, boardSize.y / areaSize.y)));
+    this->view.setViewport(sf::FloatRect(0, 0, 1, areaSize.y / static_cast<float>(windowSize.y)));
+    reset();
+}
+
+void BoardCamera::clamp() {
+    sf::Vector2f size = view.getSize();
+    sf::Vector2f center = view.getCenter();
+    center.x = size.x >= boardSize.x ? boardSize.x / 2 :
+               std::min(std::max(center.x, size.x / 2), boardSize.x - size.x / 2);
+    center.y = size.y >= boardSize.y ? boardSize.y / 2 :
+               std::min(std::max(center.y, size.y / 2), boardSize.y - size.y / 2);
+    view.setCenter(center);
+}
+
+const sf::View& BoardCamera::getView() const {
+    return view;
+}
+
+bool BoardCamera::contains(const sf::Vector2i& pixel) const {
+    return pixel.x >= 0 && pixel.y >= 0 && static_cast<float>(pixel.x) < areaSize.x &&
+           static_cast<float>(pixel.y) < areaSize.y;
+}
+
+void BoardCamera::pan(const sf::Vector2f& pixels) {
+    view.move(pixels * zoom);
+    clamp();
+}
+
+void BoardCamera::zoomAt(float factor, const sf::Vector2i& pixel, const sf::RenderWindow& window) {
+    sf::Vector2f before = window.mapPixelToCoords(pixel, view);
+    zoom = std::min(std::max(zoom * factor, MIN_ZOOM), maxZoom);
+    view.setSize(areaSize * zoom);
+    view.move(before - window.mapPixelToCoords(pixel, view));
+    clamp();
+}
+
+void BoardCamera::reset() {
+    zoom = 1;
+    view.setSize(areaSize);
+    view.setCenter(areaSize / 2.0f);
+    clamp();
+}
@@ -0,0 +1,42 @@
+#ifndef MINESWEEPER_BOARD_CAMERA_H
+#define MINESWEEPER_BOARD_CAMERA_H
+
+#include <SFML/Graphics.hpp>
+#include "TileGrid.h"
+
+// Pan and zoom over the board area, the part of the window above the tray. Its view maps that area
+// onto a rectangle of board coordinates (32 per tile) that is kept on the board; the tray keeps the
+// window's default view and so stays put.
+class BoardCamera {
+private:
+    sf::View view;
+    // Board area in window pixels
+    sf::Vector2f areaSize;
+    // Whole board in board coordinates
+    sf::Vector2f boardSize;
+    // Board coordinates per window pixel; above 1 is zoomed out
+    float zoom;
+    float maxZoom;
+
+    // Keeps the view on the board, centring an axis the view is wider than
+    void clamp();
+
+public:
+    BoardCamera(const sf::Vector2u& windowSize, float trayHeight, const TileGrid& grid);
+
+    const sf::View& getView() const;
+
+    // True if a window pixel is in the board area rather than the tray
+    bool contains(const sf::Vector2i& pixel) const;
+
+    // Moves the view by a distance in window pixels
+    void pan(const sf::Vector2f& pixels);
+
+    // Zooms by a factor (below 1 is in), keeping the board point under the pixel where it is
+    void zoomAt(float factor, const sf::Vector2i& pixel, const sf::RenderWindow& window);
+
+    // Back to one tile per 32 pixels with the board's top left corner showing
+    void reset();
+};
+
+#endif //MINESWEEPER_BOARD_CAMERA_H
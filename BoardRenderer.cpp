@@ -0,0 +1,275 @@
+#include <algorithm> // std::min and std::max for clipping the view to the board
+#include <cmath> // std::floor and std::ceil for hit-testing and culling
+#include "BoardRenderer.h"
+
+namespace {
+    // Largest board side, in pixels, that gets a cache; bigger ones would take a texture of tens of
+    // megabytes, or more than the GPU allows, and only a view's worth of it shows at a time
+    const unsigned CACHE_LIMIT = 2048;
+}
+
+BoardRenderer::BoardRenderer(const AssetRegistry& assets) : assets(assets) {
+    this->baseVertices = sf::VertexArray(sf::Quads);
+    this->overlayVertices = sf::VertexArray(sf::Quads);
+    this->cacheSize = {0, 0};
+    this->cacheAvailable = false;
+    this->hintVertices = sf::VertexArray(sf::Quads);
+    // No result has that revision before the board's first change
+    this->hintRevision = ~std::uint64_t(0);
+    this->hintTiles = sf::IntRect(0, 0, 0, 0);
+    this->heatVertices = sf::VertexArray(sf::Quads);
+    this->heatRevision = ~std::uint64_t(0);
+    this->heatTiles = sf::IntRect(0, 0, 0, 0);
+    assets.copyToTexture(AssetRegistry::revealed, pausedTexture);
+    pausedTexture.setRepeated(true);
+}
+
+void BoardRenderer::appendQuad(sf::VertexArray& vertices, int col, int row, int asset) {
+    // Tiles are 32x32 pixels on screen; the image comes from its atlas region
+    float left = static_cast<float>(col) * 32;
+    float top = static_cast<float>(row) * 32;
+    sf::FloatRect region(assets.getRegion(asset));
+    float texRight = region.left + region.width;
+    float texBottom = region.top + region.height;
+    vertices.append(sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(region.left, region.top)));
+    vertices.append(sf::Vertex(sf::Vector2f(left + 32, top), sf::Vector2f(texRight, region.top)));
+    vertices.append(sf::Vertex(sf::Vector2f(left + 32, top + 32), sf::Vector2f(texRight, texBottom)));
+    vertices.append(sf::Vertex(sf::Vector2f(left, top + 32), sf::Vector2f(region.left, texBottom)));
+}
+
+// Each tile is a background quad, an optional number or mine, and an optional flag on top
+void BoardRenderer::appendTile(const Board& board, int index) {
+    const TileGrid& grid = board.getGrid();
+    int col = grid.colOf(index);
+    int row = grid.rowOf(index);
+
+    bool hasMine = grid.isMine(index);
+    bool hasFlag = grid.isFlagged(index);
+    if (grid.isRevealed(index)) {
+        if (hasMine) {
+            appendQuad(baseVertices, col, row, AssetRegistry::hidden);
+            // A won game shows every mine as flagged
+            if (board.isGameWon()) {
+                appendQuad(overlayVertices, col, row, AssetRegistry::flag);
+                return;
+            }
+            // The mine covers any flag, debug mode or not
+            appendQuad(overlayVertices, col, row, AssetRegistry::mine);
+            return;
+        }
+        appendQuad(baseVertices, col, row, AssetRegistry::revealed);
+        int numMineNeighbors = grid.countMineNeighbors(index);
+        if (numMineNeighbors != 0) {
+            appendQuad(overlayVertices, col, row, AssetRegistry::num1 + numMineNeighbors - 1);
+        }
+        return;
+    }
+
+    // Hidden tile, not yet clicked; debug mode draws mines under any flag
+    appendQuad(baseVertices, col, row, AssetRegistry::hidden);
+    if (board.isDebugMode() && hasMine) {
+        appendQuad(overlayVertices, col, row, AssetRegistry::mine);
+    }
+    if (hasFlag) {
+        appendQuad(overlayVertices, col, row, AssetRegistry::flag);
+    }
+}
+
+// (Re)create the cache when the board size changes
+bool BoardRenderer::prepareCache(const TileGrid& grid) {
+    sf::Vector2u boardSize(static_cast<unsigned>(grid.getCols() * 32), static_cast<unsigned>(grid.getRows() * 32));
+    if (boardSize == cacheSize) {
+        return false;
+    }
+    cacheSize = boardSize;
+    cacheAvailable = boardSize.x <= CACHE_LIMIT && boardSize.y <= CACHE_LIMIT && cache.create(boardSize.x, boardSize.y);
+    return true;
+}
+
+// Redraw only the tiles that changed since the last frame
+void BoardRenderer::updateCache(Board& board, bool redrawAll) {
+    const TileGrid& grid = board.getGrid();
+    baseVertices.clear();
+    overlayVertices.clear();
+    if (redrawAll || grid.isAllDirty()) {
+        for (int i = 0; i < grid.size(); i++) {
+            appendTile(board, i);
+        }
+    } else {
+        for (int index: grid.getDirtyTiles()) {
+            appendTile(board, index);
+        }
+    }
+    board.clearDirty();
+    if (baseVertices.getVertexCount() != 0) {
+        sf::RenderStates baseStates(&assets.getTexture());
+        baseStates.blendMode = sf::BlendNone;
+        cache.draw(baseVertices, baseStates);
+        cache.draw(overlayVertices, sf::RenderStates(&assets.getTexture()));
+        cache.display();
+    }
+}
+
+sf::IntRect BoardRenderer::visibleTiles(const sf::RenderWindow& window, const TileGrid& grid) const {
+    const sf::View& view = window.getView();
+    sf::Vector2f topLeft = view.getCenter() - view.getSize() / 2.0f;
+    sf::Vector2f bottomRight = topLeft + view.getSize();
+    int left = std::max(0, static_cast<int>(std::floor(topLeft.x / 32)));
+    int top = std::max(0, static_cast<int>(std::floor(topLeft.y / 32)));
+    int right = std::min(grid.getCols(), static_cast<int>(std::ceil(bottomRight.x / 32)));
+    int bottom = std::min(grid.getRows(), static_cast<int>(std::ceil(bottomRight.y / 32)));
+    return sf::IntRect(left, top, std::max(0, right - left), std::max(0, bottom - top));
+}
+
+void BoardRenderer::renderPaused(sf::RenderWindow& window, const TileGrid& grid) {
+    float width = static_cast<float>(grid.getCols() * 32);
+    float height = static_cast<float>(grid.getRows() * 32);
+    sf::Vertex quad[4] = {
+            sf::Vertex(sf::Vector2f(0, 0), sf::Vector2f(0, 0)),
+            sf::Vertex(sf::Vector2f(width, 0), sf::Vector2f(width, 0)),
+            sf::Vertex(sf::Vector2f(width, height), sf::Vector2f(width, height)),
+            sf::Vertex(sf::Vector2f(0, height), sf::Vector2f(0, height))
+    };
+    window.draw(quad, 4, sf::Quads, sf::RenderStates(&pausedTexture));
+}
+
+void BoardRenderer::render(sf::RenderWindow& window, Board& board) {
+    // Only render the revealed texture if the game is paused; the cache stays valid underneath
+    if (board.paused()) {
+        renderPaused(window, board.getGrid());
+        return;
+    }
+    const TileGrid& grid = board.getGrid();
+    bool cacheRecreated = prepareCache(grid);
+    sf::IntRect tiles = visibleTiles(window, grid);
+    if (cacheAvailable) {
+        updateCache(board, cacheRecreated);
+        sf::IntRect area(tiles.left * 32, tiles.top * 32, tiles.width * 32, tiles.height * 32);
+        sf::Sprite sprite(cache.getTexture(), area);
+        sprite.setPosition(static_cast<float>(area.left), static_cast<float>(area.top));
+        window.draw(sprite);
+        return;
+    }
+    // No cache to keep current, so the dirty tiles are not needed
+    baseVertices.clear();
+    overlayVertices.clear();
+    for (int row = tiles.top; row < tiles.top + tiles.height; row++) {
+        for (int col = tiles.left; col < tiles.left + tiles.width; col++) {
+            appendTile(board, grid.index(col, row));
+        }
+    }
+    board.clearDirty();
+    sf::RenderStates tileStates(&assets.getTexture());
+    window.draw(baseVertices, tileStates);
+    window.draw(overlayVertices, tileStates);
+}
+
+void BoardRenderer::renderEndless(sf::RenderWindow& window, const EndlessBoard& board, long long originCol,
+                                  long long originRow) {
+    baseVertices.clear();
+    overlayVertices.clear();
+    int cols = static_cast<int>((window.getSize().x + 31) / 32);
+    int rows = static_cast<int>((window.getSize().y + 31) / 32);
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < cols; col++) {
+            long long boardCol = originCol + col;
+            long long boardRow = originRow + row;
+            if (!board.isRevealed(boardCol, boardRow)) {
+                appendQuad(baseVertices, col, row, AssetRegistry::hidden);
+                if (board.isFlagged(boardCol, boardRow)) {
+                    appendQuad(overlayVertices, col, row, AssetRegistry::flag);
+                }
+            } else if (board.isMine(boardCol, boardRow)) {
+                appendQuad(baseVertices, col, row, AssetRegistry::hidden);
+                appendQuad(overlayVertices, col, row, AssetRegistry::mine);
+            } else {
+                appendQuad(baseVertices, col, row, AssetRegistry::revealed);
+                int numMineNeighbors = board.countMineNeighbors(boardCol, boardRow);
+                if (numMineNeighbors != 0) {
+                    appendQuad(overlayVertices, col, row, AssetRegistry::num1 + numMineNeighbors - 1);
+                }
+            }
+        }
+    }
+    sf::RenderStates tileStates(&assets.getTexture());
+    window.draw(baseVertices, tileStates);
+    window.draw(overlayVertices, tileStates);
+}
+
+void BoardRenderer::renderHints(sf::RenderWindow& window, const TileGrid& grid, const SolverResult& hints) {
+    sf::IntRect tiles = visibleTiles(window, grid);
+    if (hints.revision != hintRevision || tiles != hintTiles) {
+        hintRevision = hints.revision;
+        hintTiles = tiles;
+        hintVertices.clear();
+        for (int row = tiles.top; row < tiles.top + tiles.height; row++) {
+            for (int col = tiles.left; col < tiles.left + tiles.width; col++) {
+                int i = grid.index(col, row);
+                bool safe = hints.safe.test(i);
+                if (!safe && !hints.mines.test(i)) {
+                    continue;
+                }
+                sf::Color color = safe ? sf::Color(0, 200, 0, 110) : sf::Color(220, 0, 0, 110);
+                // Inset so the tile border stays visible
+                float left = static_cast<float>(col) * 32 + 4;
+                float top = static_cast<float>(row) * 32 + 4;
+                hintVertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+                hintVertices.append(sf::Vertex(sf::Vector2f(left + 24, top), color));
+                hintVertices.append(sf::Vertex(sf::Vector2f(left + 24, top + 24), color));
+                hintVertices.append(sf::Vertex(sf::Vector2f(left, top + 24), color));
+            }
+        }
+    }
+    window.draw(hintVertices);
+}
+
+void BoardRenderer::renderProbabilities(sf::RenderWindow& window, const TileGrid& grid,
+                                        const ProbabilityResult& probabilities) {
+    sf::IntRect tiles = visibleTiles(window, grid);
+    if (probabilities.revision != heatRevision || tiles != heatTiles) {
+        heatRevision = probabilities.revision;
+        heatTiles = tiles;
+        heatVertices.clear();
+        for (int row = tiles.top; row < tiles.top + tiles.height; row++) {
+            for (int col = tiles.left; col < tiles.left + tiles.width; col++) {
+                float chance = probabilities.mineChance[grid.index(col, row)];
+                if (chance == ProbabilityResult::REVEALED) {
+                    continue;
+                }
+                // Green through yellow to red
+                sf::Uint8 red = static_cast<sf::Uint8>(chance < 0.5f ? 510 * chance : 255);
+                sf::Uint8 green = static_cast<sf::Uint8>(chance < 0.5f ? 255 : 510 * (1 - chance));
+                sf::Color color(red, green, 0, 110);
+                float left = static_cast<float>(col) * 32 + 4;
+                float top = static_cast<float>(row) * 32 + 4;
+                heatVertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+                heatVertices.append(sf::Vertex(sf::Vector2f(left + 24, top), color));
+                heatVertices.append(sf::Vertex(sf::Vector2f(left + 24, top + 24), color));
+                heatVertices.append(sf::Vertex(sf::Vector2f(left, top + 24), color));
+            }
+        }
+    }
+    window.draw(heatVertices);
+}
+
+bool BoardRenderer::tileAt(const TileGrid& grid, const sf::Vector2f& boardPosition, int& col, int& row) const {
+    // Tiles are 32x32 pixels; floor so points just left of/above the board don't round onto it
+    col = static_cast<int>(std::floor(boardPosition.x / 32));
+    row = static_cast<int>(std::floor(boardPosition.y / 32));
+    return grid.inBounds(col, row);
+}
+
+void BoardRenderer::click(const sf::RenderWindow& window, const sf::View& view, const sf::Vector2i& mousePosition,
+                          Board& board, bool isLmb) const {
+    int col;
+    int row;
+    // The view handles any pan or zoom
+    if (!tileAt(board.getGrid(), window.mapPixelToCoords(mousePosition, view), col, row)) {
+        return;
+    }
+    if (isLmb) {
+        board.reveal(col, row);
+    } else {
+        board.toggleFlag(col, row);
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef MINESWEEPER_BOARD_RENDERER_H
+#define MINESWEEPER_BOARD_RENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include "AssetRegistry.h"
+#include "Board.h"
+#include "EndlessBoard.h"
+#include "ProbabilityEngine.h"
+#include "Solver.h"
+
+// SFML adapter over the headless Board. Draws the board from a cached RenderTexture: each frame only
+// the board's dirty tiles are re-drawn into the cache (as batched quads over the shared asset atlas),
+// then the visible part of the cache is drawn as one quad. Boards too large to cache are drawn tile by
+// tile, but only the tiles inside the window's current view, so a frame costs what the view shows.
+// Also maps mouse clicks onto the board's coordinate API.
+class BoardRenderer {
+private:
+    const AssetRegistry& assets;
+    // Repeating revealed-tile texture so the paused board is a single quad
+    sf::Texture pausedTexture;
+    // Opaque tile backgrounds, drawn without blending so they overwrite stale cache pixels
+    sf::VertexArray baseVertices;
+    // Numbers, mines and flags, alpha-blended on top of the backgrounds
+    sf::VertexArray overlayVertices;
+    sf::RenderTexture cache;
+    sf::Vector2u cacheSize;
+    // False if the board is too large for a render texture; visible tiles are then drawn straight to the window
+    bool cacheAvailable;
+    // Translucent squares over solver-decided tiles, rebuilt only when the hints or the visible tiles change
+    sf::VertexArray hintVertices;
+    std::uint64_t hintRevision;
+    sf::IntRect hintTiles;
+    // Heat map over hidden tiles, rebuilt only when the probabilities or the visible tiles change
+    sf::VertexArray heatVertices;
+    std::uint64_t heatRevision;
+    sf::IntRect heatTiles;
+
+    void appendQuad(sf::VertexArray& vertices, int col, int row, int asset);
+
+    void appendTile(const Board& board, int index);
+
+    // Returns true if the cache was recreated and so holds no tiles
+    bool prepareCache(const TileGrid& grid);
+
+    void updateCache(Board& board, bool redrawAll);
+
+    // Tiles that intersect the window's current view, clipped to the board
+    sf::IntRect visibleTiles(const sf::RenderWindow& window, const TileGrid& grid) const;
+
+    void renderPaused(sf::RenderWindow& window, const TileGrid& grid);
+
+public:
+    explicit BoardRenderer(const AssetRegistry& assets);
+
+    // Draws with the window's current view; consumes the board's dirty tiles
+    void render(sf::RenderWindow& window, Board& board);
+
+    // Draws the part of an endless board that fits in the window, with tile (originCol, originRow) at the
+    // top left. Rebuilt every call, so the cost follows the window size and not the explored area.
+    void renderEndless(sf::RenderWindow& window, const EndlessBoard& board, long long originCol, long long originRow);
+
+    // Tints hidden tiles the solver has decided: green for safe, red for mine
+    void renderHints(sf::RenderWindow& window, const TileGrid& grid, const SolverResult& hints);
+
+    // Shades each hidden tile by its chance of being a mine, from green (safe) to red (certain mine)
+    void renderProbabilities(sf::RenderWindow& window, const TileGrid& grid, const ProbabilityResult& probabilities);
+
+    // Tile under a point in board coordinates; false if it is off the board
+    bool tileAt(const TileGrid& grid, const sf::Vector2f& boardPosition, int& col, int& row) const;
+
+    // Left click reveals, right click toggles a flag. The view is the one the board was drawn with.
+    void click(const sf::RenderWindow& window, const sf::View& view, const sf::Vector2i& mousePosition, Board& board,
+               bool isLmb) const;
+};
+
+#endif //MINESWEEPER_BOARD_RENDERER_H
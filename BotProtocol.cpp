@@ -0,0 +1,216 @@
+#include <climits> // INT_MAX for board size checks
+#include "BotProtocol.h"
+
+namespace {
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    // Next whitespace-separated word as [start, start + length); false at the end of the line
+    bool nextWord(const std::string& line, size_t& position, size_t& start, size_t& length) {
+        while (position < line.size() && isSpace(line[position])) {
+            position++;
+        }
+        start = position;
+        while (position < line.size() && !isSpace(line[position])) {
+            position++;
+        }
+        length = position - start;
+        return length > 0;
+    }
+
+    bool nextNumber(const std::string& line, size_t& position, std::uint64_t& value) {
+        size_t start;
+        size_t length;
+        if (!nextWord(line, position, start, length) || length > 19) {
+            return false;
+        }
+        value = 0;
+        for (size_t i = start; i < start + length; i++) {
+            if (line[i] < '0' || line[i] > '9') {
+                return false;
+            }
+            value = value * 10 + static_cast<std::uint64_t>(line[i] - '0');
+        }
+        return true;
+    }
+
+    void appendNumber(std::string& out, std::uint64_t value) {
+        char digits[20];
+        int count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        while (count > 0) {
+            out += digits[--count];
+        }
+    }
+
+    char tileSymbol(const TileGrid& grid, int index) {
+        if (grid.isRevealed(index)) {
+            return grid.isMine(index) ? '*' : static_cast<char>('0' + grid.countMineNeighbors(index));
+        }
+        return grid.isFlagged(index) ? 'F' : 'H';
+    }
+}
+
+BotProtocol::BotProtocol() = default;
+
+bool BotProtocol::runCommand(const std::string& line, size_t& position, bool& wantsBoard, std::string& error) {
+    size_t start;
+    size_t length;
+    nextWord(line, position, start, length);
+    if (line.compare(start, length, "STATE") == 0) {
+        wantsBoard = true;
+        return true;
+    }
+    if (line.compare(start, length, "NEW") == 0) {
+        std::uint64_t cols;
+        std::uint64_t rows;
+        std::uint64_t mines;
+        std::uint64_t seed;
+        if (!nextNumber(line, position, cols) || !nextNumber(line, position, rows) ||
+            !nextNumber(line, position, mines) || !nextNumber(line, position, seed)) {
+            error = "NEW takes cols rows mines seed";
+            return false;
+        }
+        if (cols == 0 || rows == 0 || cols > INT_MAX / rows || mines > cols * rows) {
+            error = "invalid board size";
+            return false;
+        }
+        std::pair<int, int> dimensions(static_cast<int>(cols), static_cast<int>(rows));
+        if (board && board->getGrid().getCols() == dimensions.first && board->getGrid().getRows() == dimensions.second &&
+            board->getMines() == static_cast<int>(mines)) {
+            board->reset(seed);
+        } else {
+            board.reset(new Board(dimensions, static_cast<int>(mines), seed));
+        }
+        // A new game starts hidden everywhere; the client is expected to know that
+        shown.assign(static_cast<size_t>(board->getGrid().size()), 'H');
+        return true;
+    }
+    bool isReveal = line.compare(start, length, "REVEAL") == 0;
+    if (!isReveal && line.compare(start, length, "FLAG") != 0) {
+        error = "unknown command " + line.substr(start, length);
+        return false;
+    }
+    std::uint64_t col;
+    std::uint64_t row;
+    if (!nextNumber(line, position, col) || !nextNumber(line, position, row)) {
+        error = std::string(isReveal ? "REVEAL" : "FLAG") + " takes col row";
+        return false;
+    }
+    if (!board) {
+        error = "no game; send NEW first";
+        return false;
+    }
+    // Off-board coordinates are ignored, as they are for a click
+    int clampedCol = col > INT_MAX ? -1 : static_cast<int>(col);
+    int clampedRow = row > INT_MAX ? -1 : static_cast<int>(row);
+    if (isReveal) {
+        board->reveal(clampedCol, clampedRow);
+    } else {
+        board->toggleFlag(clampedCol, clampedRow);
+    }
+    return true;
+}
+
+void BotProtocol::appendStatus() {
+    if (!board) {
+        reply += "NOGAME";
+    } else if (board->isGameOver()) {
+        reply += board->isGameWon() ? "WON" : "LOST";
+    } else {
+        reply += "PLAYING";
+    }
+}
+
+void BotProtocol::appendChanges() {
+    // The count goes before the tiles, so they are collected separately first
+    int changed = 0;
+    changes.clear();
+    if (board) {
+        const TileGrid& grid = board->getGrid();
+        auto report = [&](int index) {
+            char symbol = tileSymbol(grid, index);
+            if (shown[index] == symbol) {
+                return;
+            }
+            shown[index] = symbol;
+            changes += ' ';
+            appendNumber(changes, static_cast<std::uint64_t>(grid.colOf(index)));
+            changes += ' ';
+            appendNumber(changes, static_cast<std::uint64_t>(grid.rowOf(index)));
+            changes += ' ';
+            changes += symbol;
+            changed++;
+        };
+        if (grid.isAllDirty()) {
+            for (int i = 0; i < grid.size(); i++) {
+                report(i);
+            }
+        } else {
+            for (int index: grid.getDirtyTiles()) {
+                report(index);
+            }
+        }
+        board->clearDirty();
+    }
+    reply += ' ';
+    appendNumber(reply, static_cast<std::uint64_t>(changed));
+    reply += changes;
+}
+
+void BotProtocol::appendBoard() {
+    reply += " BOARD";
+    if (!board) {
+        return;
+    }
+    const TileGrid& grid = board->getGrid();
+    reply += ' ';
+    appendNumber(reply, static_cast<std::uint64_t>(grid.getCols()));
+    reply += ' ';
+    appendNumber(reply, static_cast<std::uint64_t>(grid.getRows()));
+    reply += ' ';
+    for (int i = 0; i < grid.size(); i++) {
+        shown[i] = tileSymbol(grid, i);
+        reply += shown[i];
+    }
+    board->clearDirty();
+}
+
+const std::string& BotProtocol::handleLine(const std::string& line) {
+    reply.clear();
+    size_t position = 0;
+    bool wantsBoard = false;
+    std::string error;
+    while (true) {
+        size_t start;
+        size_t length;
+        size_t peek = position;
+        if (!nextWord(line, peek, start, length)) {
+            break;
+        }
+        if (!runCommand(line, position, wantsBoard, error)) {
+            // Changes made so far are still owed and go out with the next reply
+            reply = "ERR " + error;
+            return reply;
+        }
+    }
+    appendStatus();
+    if (wantsBoard) {
+        appendBoard();
+    } else {
+        appendChanges();
+    }
+    return reply;
+}
+
+void BotProtocol::run(std::istream& in, std::ostream& out) {
+    std::string line;
+    while (std::getline(in, line)) {
+        // Flushed per line so the client can read its reply; batching commands amortizes this
+        out << handleLine(line) << '\n' << std::flush;
+    }
+}
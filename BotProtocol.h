@@ -0,0 +1,50 @@
+#ifndef MINESWEEPER_BOT_PROTOCOL_H
+#define MINESWEEPER_BOT_PROTOCOL_H
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Board.h"
+
+// Line-based text protocol for driving games from another process over stdin/stdout.
+// A line holds any number of whitespace-separated commands, run in order:
+//   NEW cols rows mines seed   start a game (reuses the board when the size and mine count match)
+//   REVEAL col row             same rules as a left click
+//   FLAG col row               toggles a flag, like a right click
+//   STATE                      reply with the whole board instead of the changes
+// Each line gets exactly one reply line:
+//   status count col row tile ...   the tiles whose visible state changed since the last reply
+//   status BOARD cols rows tiles    after STATE: every tile, row-major, as one word
+//   ERR message                     a bad command; commands before it ran, the rest of the line did not
+// status is NOGAME, PLAYING, WON or LOST. A tile is H (hidden), F (flagged), * (mine shown) or its
+// revealed count 0-8.
+class BotProtocol {
+private:
+    std::unique_ptr<Board> board;
+    // What the client was last told about each tile
+    std::vector<char> shown;
+    // Kept between lines so replies reuse their buffers
+    std::string reply;
+    std::string changes;
+
+    bool runCommand(const std::string& line, size_t& position, bool& wantsBoard, std::string& error);
+
+    void appendStatus();
+
+    // Reports the tiles that changed since the last reply, found through the grid's dirty list
+    void appendChanges();
+
+    void appendBoard();
+
+public:
+    BotProtocol();
+
+    // Runs one line of commands and returns the reply, without a newline
+    const std::string& handleLine(const std::string& line);
+
+    // Replies to each line of input until it ends
+    void run(std::istream& in, std::ostream& out);
+};
+
+#endif //MINESWEEPER_BOT_PROTOCOL_H
@@ -0,0 +1,342 @@
+#include <cstdlib> // std::llabs
+#include "EndlessBoard.h"
+#include "Rng.h"
+
+const long long EndlessBoard::COORDINATE_LIMIT;
+
+EndlessBoard::EndlessBoard(double density, std::uint64_t seed) {
+    density = density < 0 ? 0 : (density > 1 ? 1 : density);
+    this->mineThreshold = static_cast<std::uint64_t>(density * 4294967296.0);
+    this->seed = seed;
+    this->cachedKey = 0;
+    this->cachedChunk = nullptr;
+    this->started = false;
+    this->safeCol = 0;
+    this->safeRow = 0;
+    this->gameOver = false;
+    this->numRevealed = 0;
+    this->numFlagged = 0;
+    this->revision = 0;
+}
+
+long long EndlessBoard::chunkOf(long long coordinate) {
+    // Floor division, so tiles at -1 and -64 share a chunk
+    return coordinate >= 0 ? coordinate / CHUNK_SIZE : -((-coordinate + CHUNK_SIZE - 1) / CHUNK_SIZE);
+}
+
+std::uint64_t EndlessBoard::chunkKey(long long chunkCol, long long chunkRow) {
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkCol)) << 32 |
+           static_cast<std::uint32_t>(chunkRow);
+}
+
+bool EndlessBoard::hashedMine(long long col, long long row) const {
+    long long chunkCol = chunkOf(col);
+    long long chunkRow = chunkOf(row);
+    std::uint64_t stream = Rng::hash(seed ^ Rng::hash(chunkKey(chunkCol, chunkRow)));
+    std::uint64_t tile = static_cast<std::uint64_t>((row - chunkRow * CHUNK_SIZE) * CHUNK_SIZE +
+                                                    (col - chunkCol * CHUNK_SIZE));
+    return (Rng::hash(stream + tile) >> 32) < mineThreshold;
+}
+
+bool EndlessBoard::isMine(long long col, long long row) const {
+    if (started && std::llabs(col - safeCol) <= 1 && std::llabs(row - safeRow) <= 1) {
+        return false;
+    }
+    return hashedMine(col, row);
+}
+
+EndlessBoard::Chunk& EndlessBoard::loadChunk(long long chunkCol, long long chunkRow) {
+    std::uint64_t key = chunkKey(chunkCol, chunkRow);
+    std::unordered_map<std::uint64_t, Chunk>::iterator found = chunks.find(key);
+    if (found != chunks.end()) {
+        return found->second;
+    }
+    Chunk& chunk = chunks[key];
+    chunk.touched = 0;
+    // Mines for the chunk plus a one-tile border, so the counts never need a neighboring chunk
+    const int span = CHUNK_SIZE + 2;
+    bool mines[span * span];
+    long long left = chunkCol * CHUNK_SIZE - 1;
+    long long top = chunkRow * CHUNK_SIZE - 1;
+    for (int y = 0; y < span; y++) {
+        for (int x = 0; x < span; x++) {
+            mines[y * span + x] = isMine(left + x, top + y);
+        }
+    }
+    for (int y = 0; y < CHUNK_SIZE; y++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            const bool* above = &mines[y * span + x];
+            int adjacent = above[0] + above[1] + above[2] + above[span] + above[span + 2] + above[2 * span] +
+                           above[2 * span + 1] + above[2 * span + 2];
+            chunk.cells[y * CHUNK_SIZE + x] =
+                    static_cast<std::uint8_t>((above[span + 1] ? MINE : 0) | adjacent << ADJACENT_SHIFT);
+        }
+    }
+    // Put back what the player did here before it was evicted
+    std::unordered_map<std::uint64_t, std::vector<std::uint8_t>>::iterator saved = compressed.find(key);
+    if (saved != compressed.end()) {
+        int tile = 0;
+        for (size_t i = 0; i + 1 < saved->second.size(); i += 2) {
+            std::uint8_t bits = saved->second[i];
+            for (int run = 0; run < saved->second[i + 1]; run++, tile++) {
+                chunk.cells[tile] = static_cast<std::uint8_t>(chunk.cells[tile] | bits);
+                chunk.touched += bits != 0 ? 1 : 0;
+            }
+        }
+        compressed.erase(saved);
+    }
+    return chunk;
+}
+
+std::uint8_t& EndlessBoard::cellAt(long long col, long long row) {
+    long long chunkCol = chunkOf(col);
+    long long chunkRow = chunkOf(row);
+    std::uint64_t key = chunkKey(chunkCol, chunkRow);
+    if (cachedChunk == nullptr || key != cachedKey) {
+        cachedChunk = &loadChunk(chunkCol, chunkRow);
+        cachedKey = key;
+    }
+    return cachedChunk->cells[(row - chunkRow * CHUNK_SIZE) * CHUNK_SIZE + (col - chunkCol * CHUNK_SIZE)];
+}
+
+std::uint8_t EndlessBoard::peekCell(long long col, long long row) const {
+    long long chunkCol = chunkOf(col);
+    long long chunkRow = chunkOf(row);
+    std::uint64_t key = chunkKey(chunkCol, chunkRow);
+    int tile = static_cast<int>((row - chunkRow * CHUNK_SIZE) * CHUNK_SIZE + (col - chunkCol * CHUNK_SIZE));
+    std::unordered_map<std::uint64_t, Chunk>::const_iterator found = chunks.find(key);
+    if (found != chunks.end()) {
+        return found->second.cells[tile];
+    }
+    std::uint8_t cell = isMine(col, row) ? MINE : 0;
+    std::unordered_map<std::uint64_t, std::vector<std::uint8_t>>::const_iterator saved = compressed.find(key);
+    if (saved == compressed.end()) {
+        return cell;
+    }
+    for (size_t i = 0; i + 1 < saved->second.size(); i += 2) {
+        tile -= saved->second[i + 1];
+        if (tile < 0) {
+            cell = static_cast<std::uint8_t>(cell | saved->second[i]);
+            break;
+        }
+    }
+    if ((cell & REVEALED) != 0) {
+        int adjacent = 0;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                adjacent += (dx != 0 || dy != 0) && isMine(col + dx, row + dy) ? 1 : 0;
+            }
+        }
+        cell = static_cast<std::uint8_t>(cell | adjacent << ADJACENT_SHIFT);
+    }
+    return cell;
+}
+
+void EndlessBoard::compress(std::uint64_t key, const Chunk& chunk) {
+    std::vector<std::uint8_t>& runs = compressed[key];
+    runs.clear();
+    for (int tile = 0; tile < CHUNK_TILES;) {
+        std::uint8_t bits = static_cast<std::uint8_t>(chunk.cells[tile] & PLAYER_BITS);
+        int run = 1;
+        while (tile + run < CHUNK_TILES && run < 255 && (chunk.cells[tile + run] & PLAYER_BITS) == bits) {
+            run++;
+        }
+        runs.push_back(bits);
+        runs.push_back(static_cast<std::uint8_t>(run));
+        tile += run;
+    }
+    runs.shrink_to_fit();
+}
+
+bool EndlessBoard::isRevealed(long long col, long long row) const {
+    return (peekCell(col, row) & REVEALED) != 0;
+}
+
+bool EndlessBoard::isFlagged(long long col, long long row) const {
+    return (peekCell(col, row) & FLAGGED) != 0;
+}
+
+int EndlessBoard::countMineNeighbors(long long col, long long row) const {
+    std::uint8_t cell = peekCell(col, row);
+    if ((cell & REVEALED) != 0 || chunks.count(chunkKey(chunkOf(col), chunkOf(row))) != 0) {
+        return cell >> ADJACENT_SHIFT;
+    }
+    int adjacent = 0;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            adjacent += (dx != 0 || dy != 0) && isMine(col + dx, row + dy) ? 1 : 0;
+        }
+    }
+    return adjacent;
+}
+
+void EndlessBoard::setRevealed(std::uint8_t& cell) {
+    cell = static_cast<std::uint8_t>(cell | REVEALED);
+    numRevealed++;
+    cachedChunk->touched++;
+}
+
+int EndlessBoard::countFlagNeighbors(long long col, long long row) {
+    int flags = 0;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if ((dx != 0 || dy != 0) && (cellAt(col + dx, row + dy) & FLAGGED) != 0) {
+                flags++;
+            }
+        }
+    }
+    return flags;
+}
+
+void EndlessBoard::reveal(long long col, long long row) {
+    if (gameOver || std::llabs(col) > COORDINATE_LIMIT || std::llabs(row) > COORDINATE_LIMIT) {
+        return;
+    }
+    // A flagged tile ignores the reveal; checked first so it does not use up the safe opening
+    if (isFlagged(col, row)) {
+        return;
+    }
+    if (!started) {
+        started = true;
+        safeCol = col;
+        safeRow = row;
+        // Chunks built by earlier flags counted mines that are now cleared; rebuild them, keeping the flags
+        for (const std::pair<const std::uint64_t, Chunk>& loaded: chunks) {
+            compress(loaded.first, loaded.second);
+        }
+        chunks.clear();
+        cachedChunk = nullptr;
+    }
+    std::uint8_t& cell = cellAt(col, row);
+    if ((cell & MINE) != 0) {
+        setRevealed(cell);
+        gameOver = true;
+        revision++;
+        return;
+    }
+    if ((cell & REVEALED) == 0) {
+        setRevealed(cell);
+    }
+    // Same spreading rule as RevealEngine: stop at numbered tiles and next to flags
+    pending.clear();
+    pending.push_back(std::make_pair(col, row));
+    long long opened = 0;
+    while (!pending.empty() && opened < MAX_REVEAL) {
+        std::pair<long long, long long> current = pending.back();
+        pending.pop_back();
+        if ((cellAt(current.first, current.second) >> ADJACENT_SHIFT) != 0 ||
+            countFlagNeighbors(current.first, current.second) != 0) {
+            continue;
+        }
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                long long neighborCol = current.first + dx;
+                long long neighborRow = current.second + dy;
+                std::uint8_t& neighbor = cellAt(neighborCol, neighborRow);
+                if ((neighbor & REVEALED) != 0) {
+                    continue;
+                }
+                setRevealed(neighbor);
+                opened++;
+                if ((neighbor >> ADJACENT_SHIFT) == 0) {
+                    pending.push_back(std::make_pair(neighborCol, neighborRow));
+                }
+            }
+        }
+    }
+    revision++;
+}
+
+void EndlessBoard::toggleFlag(long long col, long long row) {
+    if (gameOver || std::llabs(col) > COORDINATE_LIMIT || std::llabs(row) > COORDINATE_LIMIT) {
+        return;
+    }
+    std::uint8_t& cell = cellAt(col, row);
+    if ((cell & REVEALED) != 0) {
+        return;
+    }
+    bool flagged = (cell & FLAGGED) == 0;
+    cell = static_cast<std::uint8_t>(flagged ? cell | FLAGGED : cell & ~FLAGGED);
+    numFlagged += flagged ? 1 : -1;
+    cachedChunk->touched += flagged ? 1 : -1;
+    revision++;
+}
+
+void EndlessBoard::focus(long long minCol, long long minRow, long long maxCol, long long maxRow) {
+    long long minChunkCol = chunkOf(minCol) - 1;
+    long long minChunkRow = chunkOf(minRow) - 1;
+    long long maxChunkCol = chunkOf(maxCol) + 1;
+    long long maxChunkRow = chunkOf(maxRow) + 1;
+    for (std::unordered_map<std::uint64_t, Chunk>::iterator it = chunks.begin(); it != chunks.end();) {
+        long long chunkCol = static_cast<std::int32_t>(it->first >> 32);
+        long long chunkRow = static_cast<std::int32_t>(it->first & 0xffffffffu);
+        if (chunkCol >= minChunkCol && chunkCol <= maxChunkCol && chunkRow >= minChunkRow && chunkRow <= maxChunkRow) {
+            ++it;
+            continue;
+        }
+        if (it->second.touched != 0) {
+            compress(it->first, it->second);
+        }
+        it = chunks.erase(it);
+    }
+    cachedChunk = nullptr;
+    // Only chunks with saved player bits are restored; untouched ones stay unbuilt until a reveal reaches them
+    if (compressed.empty()) {
+        return;
+    }
+    for (long long chunkRow = minChunkRow; chunkRow <= maxChunkRow; chunkRow++) {
+        for (long long chunkCol = minChunkCol; chunkCol <= maxChunkCol; chunkCol++) {
+            if (compressed.count(chunkKey(chunkCol, chunkRow)) != 0) {
+                loadChunk(chunkCol, chunkRow);
+            }
+        }
+    }
+}
+
+void EndlessBoard::reset(std::uint64_t gameSeed) {
+    this->seed = gameSeed;
+    chunks.clear();
+    compressed.clear();
+    this->cachedChunk = nullptr;
+    this->started = false;
+    this->gameOver = false;
+    this->numRevealed = 0;
+    this->numFlagged = 0;
+    this->revision++;
+}
+
+std::uint64_t EndlessBoard::getSeed() const {
+    return this->seed;
+}
+
+long long EndlessBoard::getRevealed() const {
+    return this->numRevealed;
+}
+
+long long EndlessBoard::getFlags() const {
+    return this->numFlagged;
+}
+
+bool EndlessBoard::isGameOver() const {
+    return this->gameOver;
+}
+
+std::uint64_t EndlessBoard::getRevision() const {
+    return this->revision;
+}
+
+std::size_t EndlessBoard::loadedChunks() const {
+    return chunks.size();
+}
+
+std::size_t EndlessBoard::compressedChunks() const {
+    return compressed.size();
+}
+
+std::size_t EndlessBoard::memoryBytes() const {
+    size_t bytes = chunks.size() * sizeof(Chunk);
+    for (const std::pair<const std::uint64_t, std::vector<std::uint8_t>>& saved: compressed) {
+        bytes += saved.second.capacity();
+    }
+    return bytes;
+}
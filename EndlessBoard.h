@@ -0,0 +1,122 @@
+#ifndef MINESWEEPER_ENDLESS_BOARD_H
+#define MINESWEEPER_ENDLESS_BOARD_H
+
+#include <cstddef> // size_t for the memory statistics
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// A board with no edges. Tiles live in CHUNK_SIZE x CHUNK_SIZE chunks in a hash map, created the
+// first time a reveal or flag reaches them, so memory follows the explored area.
+// Mines are a pure function of the seed: each chunk hashes (seed, chunk coordinate) into a stream key
+// and a tile is a mine if Rng::hash(key + tile) falls under the density. Any chunk can therefore be
+// built on demand, and an evicted chunk only has to keep what the player did to it.
+class EndlessBoard {
+public:
+    enum {
+        CHUNK_SIZE = 64,
+        CHUNK_TILES = CHUNK_SIZE * CHUNK_SIZE,
+        // Most tiles a single reveal opens; revealing an opened empty tile again carries on from there
+        MAX_REVEAL = 1 << 20
+    };
+
+    // Tiles further than this from the origin are ignored, which keeps chunk coordinates in 32 bits
+    static const long long COORDINATE_LIMIT = 1LL << 36;
+
+private:
+    // Same packing as TileGrid: the high nibble caches the adjacent mine count
+    enum cellBits : std::uint8_t {
+        MINE = 1 << 0, REVEALED = 1 << 1, FLAGGED = 1 << 2, PLAYER_BITS = REVEALED | FLAGGED,
+        ADJACENT_SHIFT = 4
+    };
+
+    struct Chunk {
+        std::uint8_t cells[CHUNK_TILES];
+        // Revealed or flagged tiles; a chunk without any is dropped rather than compressed
+        int touched;
+    };
+
+    std::uint64_t seed;
+    // A tile is a mine if the top 32 bits of its hash are below this
+    std::uint64_t mineThreshold;
+    std::unordered_map<std::uint64_t, Chunk> chunks;
+    // Player bits of evicted chunks, run-length encoded as (bits, run length) byte pairs
+    std::unordered_map<std::uint64_t, std::vector<std::uint8_t>> compressed;
+    // Most recent chunk looked up; a reveal mostly stays inside one chunk
+    std::uint64_t cachedKey;
+    Chunk* cachedChunk;
+    // The first reveal keeps its 3x3 neighborhood clear of mines
+    bool started;
+    long long safeCol;
+    long long safeRow;
+    bool gameOver;
+    long long numRevealed;
+    long long numFlagged;
+    std::uint64_t revision;
+    std::vector<std::pair<long long, long long>> pending;
+
+    static long long chunkOf(long long coordinate);
+
+    static std::uint64_t chunkKey(long long chunkCol, long long chunkRow);
+
+    bool hashedMine(long long col, long long row) const;
+
+    // Loads the chunk holding the tile, building or restoring it if needed
+    std::uint8_t& cellAt(long long col, long long row);
+
+    Chunk& loadChunk(long long chunkCol, long long chunkRow);
+
+    void compress(std::uint64_t key, const Chunk& chunk);
+
+    // The tile's cell without loading anything; PLAYER_BITS of unloaded, untouched tiles are clear
+    std::uint8_t peekCell(long long col, long long row) const;
+
+    // cell must have just come from cellAt, which left its chunk cached
+    void setRevealed(std::uint8_t& cell);
+
+    int countFlagNeighbors(long long col, long long row);
+
+public:
+    // density is the chance each tile is a mine, from 0 to 1
+    EndlessBoard(double density, std::uint64_t seed);
+
+    bool isMine(long long col, long long row) const;
+
+    bool isRevealed(long long col, long long row) const;
+
+    bool isFlagged(long long col, long long row) const;
+
+    int countMineNeighbors(long long col, long long row) const;
+
+    // Reveal floods through empty tiles across chunk borders. Revealing a mine ends the game.
+    void reveal(long long col, long long row);
+
+    void toggleFlag(long long col, long long row);
+
+    // Keeps chunks within a chunk of the tile rectangle loaded: inside, evicted chunks are restored;
+    // outside, untouched chunks are dropped and the rest compressed
+    void focus(long long minCol, long long minRow, long long maxCol, long long maxRow);
+
+    // A new game from the given seed
+    void reset(std::uint64_t gameSeed);
+
+    std::uint64_t getSeed() const;
+
+    long long getRevealed() const;
+
+    long long getFlags() const;
+
+    bool isGameOver() const;
+
+    std::uint64_t getRevision() const;
+
+    std::size_t loadedChunks() const;
+
+    std::size_t compressedChunks() const;
+
+    // Heap bytes held by loaded and compressed chunks, not counting hash map overhead
+    std::size_t memoryBytes() const;
+};
+
+#endif //MINESWEEPER_ENDLESS_BOARD_H
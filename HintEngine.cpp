@@ -0,0 +1,103 @@
+#include <utility> // std::swap
+#include "HintEngine.h"
+
+HintEngine::HintEngine() : cancelled(false) {
+    this->pendingWithProbabilities = false;
+    this->hasInput = false;
+    this->solving = false;
+    this->stopping = false;
+    this->hasNewResult = false;
+    this->hasNewProbabilities = false;
+    this->workingWithProbabilities = false;
+    // Started last, once everything it reads is ready
+    this->thread = std::thread(&HintEngine::run, this);
+}
+
+HintEngine::~HintEngine() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cancelled.store(true);
+    inputAvailable.notify_one();
+    thread.join();
+}
+
+void HintEngine::submit(const Board& board, bool withProbabilities) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingInput.capture(board);
+        pendingWithProbabilities = withProbabilities;
+        hasInput = true;
+        // Under the lock: set after the worker takes this input, it would cancel this input's own solve
+        cancelled.store(true);
+    }
+    inputAvailable.notify_one();
+}
+
+bool HintEngine::poll(SolverResult& result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!hasNewResult) {
+        return false;
+    }
+    std::swap(result, published);
+    hasNewResult = false;
+    return true;
+}
+
+bool HintEngine::pollProbabilities(ProbabilityResult& result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!hasNewProbabilities) {
+        return false;
+    }
+    std::swap(result, publishedProbabilities);
+    hasNewProbabilities = false;
+    return true;
+}
+
+bool HintEngine::isBusy() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hasInput || solving;
+}
+
+void HintEngine::run() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            inputAvailable.wait(lock, [this]() { return stopping || hasInput; });
+            if (stopping) {
+                return;
+            }
+            // Swap so neither side reallocates its tile buffer on every click
+            std::swap(workingInput, pendingInput);
+            workingWithProbabilities = pendingWithProbabilities;
+            hasInput = false;
+            solving = true;
+            cancelled.store(false);
+        }
+        bool finished = solver.solve(workingInput, workingResult, cancelled);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // A cancelled solve is simply dropped; the newer input is already waiting
+            finished = finished && !hasInput;
+            if (finished) {
+                // Copied, not swapped: the probabilities below still need it. Assignment reuses the buffers.
+                published = workingResult;
+                hasNewResult = true;
+            }
+            solving = finished && workingWithProbabilities;
+            if (!solving) {
+                continue;
+            }
+        }
+        // Seeded from the revision, so the same board always gets the same estimate
+        finished = probabilityEngine.estimate(workingInput, workingResult, workingProbabilities,
+                                              workingInput.revision, cancelled);
+        std::lock_guard<std::mutex> lock(mutex);
+        solving = false;
+        if (finished && !hasInput) {
+            std::swap(publishedProbabilities, workingProbabilities);
+            hasNewProbabilities = true;
+        }
+    }
+}
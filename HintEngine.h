@@ -0,0 +1,63 @@
+#ifndef MINESWEEPER_HINT_ENGINE_H
+#define MINESWEEPER_HINT_ENGINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "ProbabilityEngine.h"
+#include "Solver.h"
+
+// Runs the Solver, and optionally the ProbabilityEngine after it, on its own thread. Submitting a newer
+// board cancels the work in progress and restarts on the newest one, so the published results always
+// describe the latest board it has finished.
+class HintEngine {
+private:
+    mutable std::mutex mutex;
+    std::condition_variable inputAvailable;
+    // Guarded by mutex
+    SolverInput pendingInput;
+    bool pendingWithProbabilities;
+    bool hasInput;
+    bool solving;
+    bool stopping;
+    SolverResult published;
+    bool hasNewResult;
+    ProbabilityResult publishedProbabilities;
+    bool hasNewProbabilities;
+    // Set by submit() to abandon the current solve early
+    std::atomic<bool> cancelled;
+    // Only touched by the worker thread
+    Solver solver;
+    SolverInput workingInput;
+    SolverResult workingResult;
+    bool workingWithProbabilities;
+    ProbabilityEngine probabilityEngine;
+    ProbabilityResult workingProbabilities;
+    std::thread thread;
+
+    void run();
+
+public:
+    HintEngine();
+
+    ~HintEngine();
+
+    HintEngine(const HintEngine&) = delete;
+
+    HintEngine& operator=(const HintEngine&) = delete;
+
+    // Captures what the player can see now and queues it for solving, and for mine probabilities if asked
+    void submit(const Board& board, bool withProbabilities);
+
+    // Copies out a result newer than the last one taken; false if there is none. Never blocks on a solve.
+    bool poll(SolverResult& result);
+
+    // Same for probabilities, which arrive after the solver's result for the same board
+    bool pollProbabilities(ProbabilityResult& result);
+
+    // True while a submitted board has not been fully processed yet
+    bool isBusy() const;
+};
+
+#endif //MINESWEEPER_HINT_ENGINE_H
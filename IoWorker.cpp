@@ -0,0 +1,33 @@
+#include "IoWorker.h"
+
+IoWorker::IoWorker() {
+    this->stopping = false;
+    // Started last, once the queue it reads from is ready
+    this->thread = std::thread(&IoWorker::run, this);
+}
+
+IoWorker::~IoWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_one();
+    thread.join();
+}
+
+void IoWorker::run() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            // Drain everything that was queued before stopping
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
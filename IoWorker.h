@@ -0,0 +1,55 @@
+#ifndef MINESWEEPER_IO_WORKER_H
+#define MINESWEEPER_IO_WORKER_H
+
+#include <condition_variable>
+#include <deque> // Pending tasks, run in submission order
+#include <functional>
+#include <future> // Results handed back to the submitting thread
+#include <memory> // std::shared_ptr to make packaged tasks copyable
+#include <mutex>
+#include <thread>
+
+// Single background thread that runs file I/O off the render thread. Tasks run one at a time in
+// submission order, so state only touched from tasks needs no locking. Results (and exceptions)
+// come back through std::future; poll them with wait_for(0) to stay non-blocking.
+// Destruction finishes every queued task before the thread exits, so pending writes are flushed.
+class IoWorker {
+private:
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::deque<std::function<void()>> tasks;
+    bool stopping;
+    std::thread thread;
+
+    void run();
+
+public:
+    IoWorker();
+
+    ~IoWorker();
+
+    IoWorker(const IoWorker&) = delete;
+
+    IoWorker& operator=(const IoWorker&) = delete;
+
+    template<typename Function>
+    std::future<typename std::result_of<Function()>::type> submit(Function function) {
+        typedef typename std::result_of<Function()>::type Result;
+        auto task = std::make_shared<std::packaged_task<Result()>>(function);
+        std::future<Result> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace_back([task]() { (*task)(); });
+        }
+        taskAvailable.notify_one();
+        return result;
+    }
+
+    // True once the future's task has finished; never blocks
+    template<typename Result>
+    static bool isReady(const std::future<Result>& result) {
+        return result.valid() && result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+};
+
+#endif //MINESWEEPER_IO_WORKER_H
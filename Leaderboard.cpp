@@ -0,0 +1,225 @@
+#include <algorithm> // std::equal
+#include <cstdio> // std::rename, std::remove
+#include <fstream>
+#include <iterator> // std::prev
+#include <iomanip>
+#include <sstream>
+#include "Leaderboard.h"
+
+namespace {
+    // Log layout: 4-byte magic, then records of [u32 little-endian milliseconds][u8 name length][name]
+    const char LOG_MAGIC[4] = {'M', 'S', 'L', '1'};
+
+    void writeRecord(std::ostream& logFile, int timeMs, const std::string& name) {
+        auto time = static_cast<unsigned>(timeMs);
+        // Names are at most 10 characters, but never let one overflow the length byte
+        auto length = static_cast<unsigned char>(name.size() > 255 ? 255 : name.size());
+        char header[5] = {static_cast<char>(time & 0xFF), static_cast<char>(time >> 8 & 0xFF),
+                          static_cast<char>(time >> 16 & 0xFF), static_cast<char>(time >> 24 & 0xFF),
+                          static_cast<char>(length)};
+        logFile.write(header, 5);
+        logFile.write(name.data(), length);
+    }
+}
+
+bool Leaderboard::Entry::operator<(const Entry& other) const {
+    if (timeMs != other.timeMs) {
+        return timeMs < other.timeMs;
+    }
+    return sequence < other.sequence;
+}
+
+Leaderboard::Leaderboard(const std::string& logPath, const std::string& textPath) {
+    this->logPath = logPath;
+    this->textPath = textPath;
+    this->nextSequence = 0;
+    this->logRecords = 0;
+}
+
+// O(log K): insert, then drop the slowest if over capacity
+bool Leaderboard::insertEntry(int timeMs, const std::string& name) {
+    Entry entry = {timeMs, nextSequence++, name};
+    if (static_cast<int>(topEntries.size()) == CAPACITY && !(entry < *topEntries.rbegin())) {
+        return false;
+    }
+    topEntries.insert(entry);
+    if (static_cast<int>(topEntries.size()) > CAPACITY) {
+        topEntries.erase(std::prev(topEntries.end()));
+    }
+    return true;
+}
+
+void Leaderboard::load() {
+    topEntries.clear();
+    logRecords = 0;
+    if (!readLog()) {
+        // First run: seed the log from the text leaderboard
+        importText();
+        compact();
+        return;
+    }
+    if (logRecords > CAPACITY) {
+        compact();
+    }
+}
+
+bool Leaderboard::readLog() {
+    std::ifstream logFile(logPath, std::ios::binary);
+    if (!logFile.good()) {
+        return false;
+    }
+    char magic[4];
+    if (!logFile.read(magic, 4) || !std::equal(magic, magic + 4, LOG_MAGIC)) {
+        return false;
+    }
+    unsigned char header[5];
+    // A torn final record (crash mid-append) is ignored
+    while (logFile.read(reinterpret_cast<char*>(header), 5)) {
+        int timeMs = static_cast<int>(header[0] | header[1] << 8 | header[2] << 16 |
+                                      static_cast<unsigned>(header[3]) << 24);
+        std::string entryName(header[4], '\0');
+        if (!logFile.read(&entryName[0], header[4])) {
+            break;
+        }
+        insertEntry(timeMs, entryName);
+        logRecords++;
+    }
+    return true;
+}
+
+void Leaderboard::importText() {
+    std::ifstream leaderboardFile(textPath);
+    if (!leaderboardFile.good()) {
+        throw file_read_exception("Failed to open files/leaderboard.txt!");
+    }
+    // Lines look like "mm:ss,Name" or "mm:ss, Name"
+    std::string line;
+    while (std::getline(leaderboardFile, line)) {
+        size_t comma = line.find(',');
+        size_t colon = line.find(':');
+        if (comma == std::string::npos || colon == std::string::npos || colon > comma) {
+            continue;
+        }
+        std::string entryName = line.substr(comma + 1);
+        if (!entryName.empty() && entryName[0] == ' ') {
+            entryName.erase(0, 1);
+        }
+        if (!entryName.empty() && entryName.back() == '\r') {
+            entryName.pop_back();
+        }
+        try {
+            int minutes = std::stoi(line.substr(0, colon));
+            int seconds = std::stoi(line.substr(colon + 1, comma - colon - 1));
+            insertEntry((minutes * 60 + seconds) * 1000, entryName);
+        } catch (std::invalid_argument& e) {
+            continue;
+        }
+    }
+}
+
+void Leaderboard::appendRecord(int timeMs, const std::string& name) {
+    std::ofstream logFile(logPath, std::ios::binary | std::ios::app);
+    if (!logFile.good()) {
+        throw file_read_exception("Failed to open the leaderboard log!");
+    }
+    writeRecord(logFile, timeMs, name);
+    logRecords++;
+}
+
+int Leaderboard::addScore(int timeMs, const std::string& name) {
+    bool placed = insertEntry(timeMs, name);
+    appendRecord(timeMs, name);
+    if (!placed) {
+        return 0;
+    }
+    writeText();
+    if (logRecords > 2 * CAPACITY) {
+        compact();
+    }
+    // The newest entry has the highest sequence number
+    int rank = 1;
+    for (const Entry& entry: topEntries) {
+        if (entry.sequence == nextSequence - 1) {
+            return rank;
+        }
+        rank++;
+    }
+    return 0;
+}
+
+void Leaderboard::compact() {
+    writeLog();
+    writeText();
+    logRecords = static_cast<int>(topEntries.size());
+}
+
+void Leaderboard::writeLog() const {
+    std::string tempPath = logPath + ".tmp";
+    {
+        std::ofstream logFile(tempPath, std::ios::binary | std::ios::trunc);
+        if (!logFile.good()) {
+            throw file_read_exception("Failed to write the leaderboard log!");
+        }
+        logFile.write(LOG_MAGIC, 4);
+        for (const Entry& entry: topEntries) {
+            writeRecord(logFile, entry.timeMs, entry.name);
+        }
+    }
+    replaceFile(tempPath, logPath);
+}
+
+// Keep files/leaderboard.txt in its original "mm:ss,Name" format for anything that reads it
+void Leaderboard::writeText() const {
+    std::string tempPath = textPath + ".tmp";
+    {
+        std::ofstream leaderboardFile(tempPath, std::ios::trunc);
+        if (!leaderboardFile.good()) {
+            throw file_read_exception("Failed to write files/leaderboard.txt!");
+        }
+        bool first = true;
+        for (const Entry& entry: topEntries) {
+            if (!first) {
+                leaderboardFile << '\n';
+            }
+            leaderboardFile << formatTime(entry.timeMs) << "," << entry.name;
+            first = false;
+        }
+    }
+    replaceFile(tempPath, textPath);
+}
+
+void Leaderboard::replaceFile(const std::string& tempPath, const std::string& path) {
+    // rename() replaces atomically on POSIX; Windows refuses to rename over an existing file
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(path.c_str());
+        if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+            throw file_read_exception("Failed to replace a leaderboard file!");
+        }
+    }
+}
+
+std::string Leaderboard::toString(int highlightRank) const {
+    std::string contentString;
+    int iteration = 1;
+    for (const Entry& entry: topEntries) {
+        contentString.append(std::to_string(iteration)).append(".\t").append(formatTime(entry.timeMs))
+                .append("\t").append(entry.name);
+        if (iteration == highlightRank) {
+            contentString += "*";
+        }
+        contentString.append("\n\n");
+        iteration++;
+    }
+    return contentString;
+}
+
+std::string Leaderboard::formatTime(int timeMs) {
+    int totalSeconds = timeMs / 1000;
+    int minutes = totalSeconds / 60;
+    if (minutes >= 99) {
+        minutes = 99;
+    }
+    std::stringstream formattedTime;
+    formattedTime << std::setfill('0') << std::setw(2) << minutes << ":" << std::setw(2) << totalSeconds % 60;
+    return formattedTime.str();
+}
@@ -0,0 +1,67 @@
+#ifndef MINESWEEPER_LEADERBOARD_H
+#define MINESWEEPER_LEADERBOARD_H
+
+#include <set> // Ordered top-K index
+#include <string>
+#include "file_read_exception.h"
+
+// Leaderboard storage. Scores live in a compact append-only binary log of integer milliseconds,
+// loaded once into an in-memory top-K index; everything the UI asks for is answered from memory.
+// Compaction rewrites the log to just the top K, and the human-readable leaderboard.txt export
+// is refreshed whenever the top K changes. Both are written to a temp file and renamed into place.
+class Leaderboard {
+public:
+    // Number of places kept and shown
+    static const int CAPACITY = 5;
+
+    struct Entry {
+        int timeMs;
+        // Insertion order; breaks ties in favor of the earlier score
+        long long sequence;
+        std::string name;
+
+        bool operator<(const Entry& other) const;
+    };
+
+private:
+    std::string logPath;
+    std::string textPath;
+    std::multiset<Entry> topEntries;
+    long long nextSequence;
+    // Records in the log file, including ones that no longer place
+    int logRecords;
+
+    bool insertEntry(int timeMs, const std::string& name);
+
+    bool readLog();
+
+    void importText();
+
+    void appendRecord(int timeMs, const std::string& name);
+
+    void writeLog() const;
+
+    void writeText() const;
+
+    static void replaceFile(const std::string& tempPath, const std::string& path);
+
+public:
+    Leaderboard(const std::string& logPath, const std::string& textPath);
+
+    // Reads the log, or imports the text leaderboard on first run. Throws file_read_exception
+    // if neither can be read.
+    void load();
+
+    // Records a score; returns its 1-based place, or 0 if it did not make the leaderboard
+    int addScore(int timeMs, const std::string& name);
+
+    // Rewrite the log to just the current top K
+    void compact();
+
+    // "1.\tmm:ss\tName" lines; the place given by highlightRank is marked with a '*'
+    std::string toString(int highlightRank) const;
+
+    static std::string formatTime(int timeMs);
+};
+
+#endif //MINESWEEPER_LEADERBOARD_H
@@ -0,0 +1,66 @@
+#include "MineSampler.h"
+
+namespace {
+    // The position-th tile (0-based) that is not in the ascending excluded list
+    int skipExcluded(int position, const int* excluded, int numExcluded) {
+        for (int i = 0; i < numExcluded && excluded[i] <= position; i++) {
+            position++;
+        }
+        return position;
+    }
+}
+
+MineSampler::MineSampler(std::uint64_t seed) : rng(seed) {
+}
+
+void MineSampler::reseed(std::uint64_t seed) {
+    this->rng = Rng(seed);
+}
+
+void MineSampler::placeMines(TileGrid& grid, int count, int safeIndex) {
+    int size = grid.size();
+    if (count > size) {
+        count = size;
+    }
+    // Tiles kept clear, in ascending order. Shrinks to just the safe tile, then to nothing,
+    // if the mines would not otherwise fit.
+    int excluded[9];
+    int numExcluded = 0;
+    if (safeIndex != -1) {
+        int neighbors[8];
+        int numNeighbors = grid.getNeighbors(safeIndex, neighbors);
+        if (count <= size - 1 - numNeighbors) {
+            // Neighbors come back in row-major order: those before the safe tile, then those after
+            for (int i = 0; i < numNeighbors && neighbors[i] < safeIndex; i++) {
+                excluded[numExcluded++] = neighbors[i];
+            }
+            excluded[numExcluded++] = safeIndex;
+            for (int i = 0; i < numNeighbors; i++) {
+                if (neighbors[i] > safeIndex) {
+                    excluded[numExcluded++] = neighbors[i];
+                }
+            }
+        } else if (count <= size - 1) {
+            excluded[numExcluded++] = safeIndex;
+        }
+    }
+    int available = size - numExcluded;
+    // Floyd: for each of the last `count` positions j, take a random position in [0, j], or j itself if
+    // that one is already taken. Every subset of the right size is equally likely.
+    if (count <= available / 2) {
+        for (int j = available - count; j < available; j++) {
+            int index = skipExcluded(rng.uniform(0, j), excluded, numExcluded);
+            grid.setMine(grid.isMine(index) ? skipExcluded(j, excluded, numExcluded) : index, true);
+        }
+        return;
+    }
+    // Dense board: fill it, clear the excluded tiles, then choose the (fewer) safe tiles the same way
+    grid.fillMines();
+    for (int i = 0; i < numExcluded; i++) {
+        grid.setMine(excluded[i], false);
+    }
+    for (int j = count; j < available; j++) {
+        int index = skipExcluded(rng.uniform(0, j), excluded, numExcluded);
+        grid.setMine(grid.isMine(index) ? index : skipExcluded(j, excluded, numExcluded), false);
+    }
+}
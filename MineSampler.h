@@ -0,0 +1,27 @@
+#ifndef MINESWEEPER_MINE_SAMPLER_H
+#define MINESWEEPER_MINE_SAMPLER_H
+
+#include <cstdint> // Seeds
+#include "Rng.h"
+#include "TileGrid.h"
+
+// Exact mine placement in one draw per mine, at any density. Uses Floyd's form of the partial
+// Fisher-Yates shuffle: the grid's own mine bits record which tiles are taken, so no index buffer
+// has to be built or touched at random.
+class MineSampler {
+private:
+    Rng rng;
+
+public:
+    explicit MineSampler(std::uint64_t seed);
+
+    // Restart the stream; the same seed and first click always give the same mines
+    void reseed(std::uint64_t seed);
+
+    // Places exactly min(count, size) mines on a grid that has none. The tile at safeIndex is kept
+    // clear, and its 3x3 neighborhood too when there is room; pass -1 to allow mines anywhere.
+    // Above 50% density the safe tiles are chosen instead, on a grid that starts out full of mines.
+    void placeMines(TileGrid& grid, int count, int safeIndex);
+};
+
+#endif //MINESWEEPER_MINE_SAMPLER_H
@@ -0,0 +1,503 @@
+#include <algorithm> // std::max, std::min
+#include <cmath> // std::lgamma, std::exp, std::ldexp
+#include <thread> // Task workers
+#include "ProbabilityEngine.h"
+#include "Rng.h"
+
+namespace {
+    // On-board neighbors of a tile, like TileGrid::getNeighbors
+    int neighborsOf(const SolverInput& input, int index, int (&neighbors)[8]) {
+        int col = index % input.cols;
+        int row = index / input.cols;
+        int numNeighbors = 0;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int neighborCol = col + dx;
+                int neighborRow = row + dy;
+                if ((dx == 0 && dy == 0) || neighborCol < 0 || neighborCol >= input.cols || neighborRow < 0 ||
+                    neighborRow >= input.rows) {
+                    continue;
+                }
+                neighbors[numNeighbors++] = neighborRow * input.cols + neighborCol;
+            }
+        }
+        return numNeighbors;
+    }
+
+    // A partial assignment of one component's tiles, with running totals for every constraint
+    struct Search {
+        const std::vector<int>& need;
+        const std::vector<int>& width;
+        const std::vector<int>& constraintStart;
+        const std::vector<int>& tileConstraints;
+        // Per constraint: mines placed so far, and tiles not yet assigned
+        std::vector<int> placed;
+        std::vector<int> open;
+        std::vector<char> isMine;
+        int mines;
+
+        Search(const std::vector<int>& need, const std::vector<int>& width, const std::vector<int>& constraintStart,
+               const std::vector<int>& tileConstraints)
+                : need(need), width(width), constraintStart(constraintStart), tileConstraints(tileConstraints) {
+            this->mines = 0;
+            reset();
+        }
+
+        void reset() {
+            placed.assign(need.size(), 0);
+            open = width;
+            isMine.assign(constraintStart.size() - 1, 0);
+            mines = 0;
+        }
+
+        // True if every constraint around the tile can still be met with this value
+        bool allows(int tile, int value) const {
+            for (int i = constraintStart[tile]; i < constraintStart[tile + 1]; i++) {
+                int constraint = tileConstraints[i];
+                int mineTotal = placed[constraint] + value;
+                if (mineTotal > need[constraint] || mineTotal + open[constraint] - 1 < need[constraint]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void assign(int tile, int value) {
+            for (int i = constraintStart[tile]; i < constraintStart[tile + 1]; i++) {
+                placed[tileConstraints[i]] += value;
+                open[tileConstraints[i]]--;
+            }
+            isMine[tile] = static_cast<char>(value);
+            mines += value;
+        }
+
+        void unassign(int tile) {
+            int value = isMine[tile];
+            for (int i = constraintStart[tile]; i < constraintStart[tile + 1]; i++) {
+                placed[tileConstraints[i]] -= value;
+                open[tileConstraints[i]]++;
+            }
+            isMine[tile] = 0;
+            mines -= value;
+        }
+    };
+
+    // Relative weights for mine totals offset, offset + 1, ...; only ratios matter, so each is scaled to max 1
+    struct Weights {
+        int offset;
+        std::vector<double> values;
+    };
+
+    void normalize(std::vector<double>& values) {
+        double largest = 0;
+        for (double value: values) {
+            largest = std::max(largest, value);
+        }
+        if (largest > 0) {
+            for (double& value: values) {
+                value /= largest;
+            }
+        }
+    }
+
+    // Distribution of the sum of two independent totals
+    Weights convolve(const Weights& a, const Weights& b) {
+        Weights sum{a.offset + b.offset, std::vector<double>(a.values.size() + b.values.size() - 1, 0.0)};
+        for (size_t i = 0; i < a.values.size(); i++) {
+            for (size_t j = 0; j < b.values.size(); j++) {
+                sum.values[i + j] += a.values[i] * b.values[j];
+            }
+        }
+        normalize(sum.values);
+        return sum;
+    }
+}
+
+int ProbabilityResult::safestTile() const {
+    int best = -1;
+    for (int i = 0; i < static_cast<int>(mineChance.size()); i++) {
+        if (mineChance[i] != REVEALED && (best == -1 || mineChance[i] < mineChance[best])) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+ProbabilityEngine::ProbabilityEngine(int numThreads) {
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    this->numThreads = numThreads > 0 ? numThreads : 1;
+}
+
+void ProbabilityEngine::buildComponents(const SolverInput& input, const SolverResult& known, int& interior) {
+    int size = static_cast<int>(input.tiles.size());
+    constraintAt.assign(static_cast<size_t>(size), -1);
+    localIndex.assign(static_cast<size_t>(size), -1);
+    components.clear();
+    auto undecided = [&](int tile) {
+        return input.tiles[tile] == SolverInput::HIDDEN && !known.safe.test(tile) && !known.mines.test(tile);
+    };
+
+    // Each revealed number with undecided neighbors, less the mines the solver already found around it
+    std::vector<int> constraintNeed;
+    int neighbors[8];
+    for (int i = 0; i < size; i++) {
+        if (input.tiles[i] == SolverInput::HIDDEN) {
+            continue;
+        }
+        int numNeighbors = neighborsOf(input, i, neighbors);
+        int need = input.tiles[i];
+        bool hasUndecided = false;
+        for (int n = 0; n < numNeighbors; n++) {
+            need -= known.mines.test(neighbors[n]) ? 1 : 0;
+            hasUndecided = hasUndecided || undecided(neighbors[n]);
+        }
+        if (hasUndecided) {
+            constraintAt[i] = static_cast<int>(constraintNeed.size());
+            constraintNeed.push_back(need);
+        }
+    }
+
+    // Breadth-first through shared constraints, so each tile is searched soon after the tiles it
+    // interacts with and a contradiction is found early
+    std::vector<int> constraintLocal(constraintNeed.size(), -1);
+    int numUndecided = 0;
+    int frontier = 0;
+    int centers[8];
+    for (int start = 0; start < size; start++) {
+        if (!undecided(start)) {
+            continue;
+        }
+        numUndecided++;
+        if (localIndex[start] != -1) {
+            continue;
+        }
+        int numCenters = neighborsOf(input, start, centers);
+        bool onFrontier = false;
+        for (int n = 0; n < numCenters; n++) {
+            onFrontier = onFrontier || constraintAt[centers[n]] != -1;
+        }
+        if (!onFrontier) {
+            continue;
+        }
+        components.push_back(Component());
+        Component& component = components.back();
+        component.tiles.push_back(start);
+        localIndex[start] = 0;
+        for (size_t next = 0; next < component.tiles.size(); next++) {
+            int tile = component.tiles[next];
+            numCenters = neighborsOf(input, tile, centers);
+            for (int c = 0; c < numCenters; c++) {
+                int constraint = constraintAt[centers[c]];
+                if (constraint == -1) {
+                    continue;
+                }
+                if (constraintLocal[constraint] == -1) {
+                    constraintLocal[constraint] = static_cast<int>(component.need.size());
+                    component.need.push_back(constraintNeed[constraint]);
+                    component.width.push_back(0);
+                }
+                int numNeighbors = neighborsOf(input, centers[c], neighbors);
+                for (int n = 0; n < numNeighbors; n++) {
+                    if (undecided(neighbors[n]) && localIndex[neighbors[n]] == -1) {
+                        localIndex[neighbors[n]] = static_cast<int>(component.tiles.size());
+                        component.tiles.push_back(neighbors[n]);
+                    }
+                }
+            }
+        }
+        // Constraint lists per tile, in search order
+        component.constraintStart.push_back(0);
+        for (int tile: component.tiles) {
+            numCenters = neighborsOf(input, tile, centers);
+            for (int c = 0; c < numCenters; c++) {
+                int constraint = constraintAt[centers[c]];
+                if (constraint != -1) {
+                    component.tileConstraints.push_back(constraintLocal[constraint]);
+                    component.width[constraintLocal[constraint]]++;
+                }
+            }
+            component.constraintStart.push_back(static_cast<int>(component.tileConstraints.size()));
+        }
+        component.sampled = component.tiles.size() > ENUMERATE_LIMIT;
+        frontier += static_cast<int>(component.tiles.size());
+    }
+    interior = numUndecided - frontier;
+}
+
+void ProbabilityEngine::runTask(int taskIndex, const std::atomic<bool>& cancelled) {
+    const Task& task = tasks[taskIndex];
+    const Component& component = components[task.component];
+    Tally& tally = tallies[taskIndex];
+    int numTiles = static_cast<int>(component.tiles.size());
+    tally.scale = 0;
+    tally.layouts.assign(static_cast<size_t>(numTiles) + 1, 0.0);
+    tally.tileMines.assign(static_cast<size_t>(numTiles) + 1, std::vector<double>());
+    Search search(component.need, component.width, component.constraintStart, component.tileConstraints);
+    auto record = [&](double weight) {
+        tally.layouts[search.mines] += weight;
+        std::vector<double>& tileMines = tally.tileMines[search.mines];
+        if (tileMines.empty()) {
+            tileMines.assign(static_cast<size_t>(numTiles), 0.0);
+        }
+        for (int t = 0; t < numTiles; t++) {
+            if (search.isMine[t] != 0) {
+                tileMines[t] += weight;
+            }
+        }
+    };
+
+    if (task.samples == 0) {
+        // Depth-first over every consistent layout; next[t] is the value tile t tries next
+        std::vector<int> next(static_cast<size_t>(numTiles), 0);
+        long long layouts = 0;
+        int depth = 0;
+        while (depth >= 0) {
+            if (depth == numTiles) {
+                record(1.0);
+                if ((++layouts & 1023) == 0 && cancelled.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                depth--;
+                continue;
+            }
+            if (next[depth] > 0) {
+                search.unassign(depth);
+            }
+            while (next[depth] <= 1 && !search.allows(depth, next[depth])) {
+                next[depth]++;
+            }
+            if (next[depth] > 1) {
+                next[depth] = 0;
+                depth--;
+                continue;
+            }
+            search.assign(depth, next[depth]);
+            next[depth]++;
+            depth++;
+        }
+        return;
+    }
+
+    Rng rng(task.stream);
+    for (int sample = 0; sample < task.samples; sample++) {
+        if (cancelled.load(std::memory_order_relaxed)) {
+            return;
+        }
+        int choices = 0;
+        bool consistent = true;
+        for (int t = 0; t < numTiles && consistent; t++) {
+            bool canBeSafe = search.allows(t, 0);
+            bool canBeMine = search.allows(t, 1);
+            consistent = canBeSafe || canBeMine;
+            if (canBeSafe && canBeMine) {
+                choices++;
+                search.assign(t, static_cast<int>(rng.next() >> 63));
+            } else if (consistent) {
+                search.assign(t, canBeMine ? 1 : 0);
+            }
+        }
+        // A dead end is a layout with weight 0
+        if (consistent) {
+            if (choices > tally.scale) {
+                double rescale = std::ldexp(1.0, tally.scale - choices);
+                for (size_t k = 0; k < tally.layouts.size(); k++) {
+                    tally.layouts[k] *= rescale;
+                    for (double& count: tally.tileMines[k]) {
+                        count *= rescale;
+                    }
+                }
+                tally.scale = choices;
+            }
+            record(std::ldexp(1.0, choices - tally.scale));
+        }
+        search.reset();
+    }
+}
+
+void ProbabilityEngine::merge(Tally& a, const Tally& b) {
+    if (a.layouts.empty()) {
+        a = b;
+        return;
+    }
+    if (b.scale > a.scale) {
+        double rescale = std::ldexp(1.0, a.scale - b.scale);
+        for (size_t k = 0; k < a.layouts.size(); k++) {
+            a.layouts[k] *= rescale;
+            for (double& count: a.tileMines[k]) {
+                count *= rescale;
+            }
+        }
+        a.scale = b.scale;
+    }
+    double rescale = std::ldexp(1.0, b.scale - a.scale);
+    for (size_t k = 0; k < a.layouts.size(); k++) {
+        a.layouts[k] += b.layouts[k] * rescale;
+        if (b.tileMines[k].empty()) {
+            continue;
+        }
+        if (a.tileMines[k].empty()) {
+            a.tileMines[k].assign(b.tileMines[k].size(), 0.0);
+        }
+        for (size_t t = 0; t < b.tileMines[k].size(); t++) {
+            a.tileMines[k][t] += b.tileMines[k][t] * rescale;
+        }
+    }
+}
+
+bool ProbabilityEngine::estimate(const SolverInput& input, const SolverResult& known, ProbabilityResult& result,
+                                 std::uint64_t seed, const std::atomic<bool>& cancelled) {
+    int size = static_cast<int>(input.tiles.size());
+    int interior;
+    buildComponents(input, known, interior);
+    result.revision = input.revision;
+    result.exact = true;
+
+    tasks.clear();
+    for (int c = 0; c < static_cast<int>(components.size()); c++) {
+        if (!components[c].sampled) {
+            tasks.push_back(Task{c, 0, 0});
+            continue;
+        }
+        result.exact = false;
+        for (int t = 0; t < SAMPLE_TASKS; t++) {
+            // Rng runs its seed through splitmix64, so consecutive stream numbers are independent streams
+            std::uint64_t stream = seed + (static_cast<std::uint64_t>(c) * SAMPLE_TASKS + t + 1) *
+                                          0x9e3779b97f4a7c15ULL;
+            tasks.push_back(Task{c, SAMPLES_PER_TASK, stream});
+        }
+    }
+    tallies.assign(tasks.size(), Tally());
+    std::atomic<size_t> nextTask(0);
+    auto work = [&]() {
+        for (size_t task = nextTask.fetch_add(1); task < tasks.size(); task = nextTask.fetch_add(1)) {
+            runTask(static_cast<int>(task), cancelled);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int i = 1; i < std::min(numThreads, static_cast<int>(tasks.size())); i++) {
+        workers.push_back(std::thread(work));
+    }
+    work();
+    for (std::thread& worker: workers) {
+        worker.join();
+    }
+    if (cancelled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    // Per component: relative weight of each mine total, over the totals that have any layout
+    std::vector<Tally> merged(components.size());
+    for (size_t t = 0; t < tasks.size(); t++) {
+        merge(merged[tasks[t].component], tallies[t]);
+    }
+    int numComponents = static_cast<int>(components.size());
+    std::vector<Weights> weights(components.size());
+    int frontier = 0;
+    for (int c = 0; c < numComponents; c++) {
+        const std::vector<double>& layouts = merged[c].layouts;
+        int low = 0;
+        int high = static_cast<int>(layouts.size()) - 1;
+        while (low < high && layouts[low] == 0) {
+            low++;
+        }
+        while (high > low && layouts[high] == 0) {
+            high--;
+        }
+        weights[c].offset = low;
+        weights[c].values.assign(layouts.begin() + low, layouts.begin() + high + 1);
+        frontier += static_cast<int>(components[c].tiles.size());
+    }
+
+    // Ways to place the remaining mines in the interior, for each total of frontier mines
+    int minesLeft = input.totalMines - known.mines.count();
+    std::vector<double> interiorWays(static_cast<size_t>(frontier) + 1, 0.0);
+    double largestLog = -HUGE_VAL;
+    for (int j = 0; j <= frontier; j++) {
+        int rest = minesLeft - j;
+        if (rest >= 0 && rest <= interior) {
+            interiorWays[j] = std::lgamma(interior + 1.0) - std::lgamma(rest + 1.0) - std::lgamma(interior - rest + 1.0);
+            largestLog = std::max(largestLog, interiorWays[j]);
+        }
+    }
+    for (int j = 0; j <= frontier; j++) {
+        int rest = minesLeft - j;
+        interiorWays[j] = rest >= 0 && rest <= interior ? std::exp(interiorWays[j] - largestLog) : 0.0;
+    }
+
+    // after[c][m]: weight of m frontier mines in components before c, given every way components c
+    // onward and the interior can complete them. Built back to front, then swept forward alongside
+    // the totals of the components already passed.
+    std::vector<std::vector<double>> after(components.size() + 1);
+    after[numComponents] = interiorWays;
+    for (int c = numComponents - 1; c >= 0; c--) {
+        after[c].assign(static_cast<size_t>(frontier) + 1, 0.0);
+        for (int m = 0; m <= frontier; m++) {
+            for (size_t k = 0; k < weights[c].values.size() && m + weights[c].offset + static_cast<int>(k) <= frontier;
+                 k++) {
+                after[c][m] += weights[c].values[k] * after[c + 1][m + weights[c].offset + k];
+            }
+        }
+        normalize(after[c]);
+    }
+
+    // Fallback for a board no layout fits, which only an incomplete sample can produce
+    int numUndecided = frontier + interior;
+    float density = numUndecided > 0 ? static_cast<float>(minesLeft) / static_cast<float>(numUndecided) : 0.0f;
+    result.mineChance.assign(static_cast<size_t>(size), 0.0f);
+    Weights before{0, std::vector<double>(1, 1.0)};
+    for (int c = 0; c < numComponents; c++) {
+        const Component& component = components[c];
+        const Weights& own = weights[c];
+        // How well each of this component's totals fits with everything else
+        std::vector<double> fit(own.values.size(), 0.0);
+        double total = 0;
+        for (size_t k = 0; k < own.values.size(); k++) {
+            for (size_t i = 0; i < before.values.size(); i++) {
+                size_t m = before.offset + i + own.offset + k;
+                if (m <= static_cast<size_t>(frontier)) {
+                    fit[k] += before.values[i] * after[c + 1][m];
+                }
+            }
+            total += own.values[k] * fit[k];
+        }
+        for (size_t t = 0; t < component.tiles.size(); t++) {
+            double mines = 0;
+            for (size_t k = 0; k < own.values.size(); k++) {
+                const std::vector<double>& tileMines = merged[c].tileMines[own.offset + k];
+                if (!tileMines.empty()) {
+                    mines += tileMines[t] * fit[k];
+                }
+            }
+            // tileMines and own.values share the tally's scale, so it cancels here
+            result.mineChance[component.tiles[t]] = total > 0 ? static_cast<float>(mines / total) : density;
+        }
+        before = convolve(before, own);
+    }
+
+    // Interior tiles share the expected leftover mines evenly
+    double ways = 0;
+    double interiorMines = 0;
+    for (size_t i = 0; i < before.values.size(); i++) {
+        size_t m = before.offset + i;
+        if (m <= static_cast<size_t>(frontier)) {
+            ways += before.values[i] * interiorWays[m];
+            interiorMines += before.values[i] * interiorWays[m] * (minesLeft - static_cast<double>(m));
+        }
+    }
+    float interiorChance = ways > 0 && interior > 0 ? static_cast<float>(interiorMines / ways / interior) : density;
+
+    for (int i = 0; i < size; i++) {
+        if (input.tiles[i] != SolverInput::HIDDEN) {
+            result.mineChance[i] = ProbabilityResult::REVEALED;
+        } else if (known.safe.test(i)) {
+            result.mineChance[i] = 0.0f;
+        } else if (known.mines.test(i)) {
+            result.mineChance[i] = 1.0f;
+        } else if (localIndex[i] == -1) {
+            result.mineChance[i] = interiorChance;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,95 @@
+#ifndef MINESWEEPER_PROBABILITY_ENGINE_H
+#define MINESWEEPER_PROBABILITY_ENGINE_H
+
+#include <atomic> // Cancellation flag shared with the UI thread
+#include <cstdint>
+#include <vector>
+#include "Solver.h"
+
+struct ProbabilityResult {
+    enum {
+        REVEALED = -1
+    };
+    std::uint64_t revision;
+    // Chance each hidden tile is a mine (0 or 1 where the solver decided it), or REVEALED
+    std::vector<float> mineChance;
+    // False if any part of the frontier was sampled instead of enumerated
+    bool exact;
+
+    // Hidden tile least likely to be a mine, lowest index on ties; -1 if nothing is hidden
+    int safestTile() const;
+};
+
+// Mine probabilities for the tiles the solver could not decide. Undecided hidden tiles next to a
+// revealed number form the frontier, which splits into components that share no constraint:
+//   - Components of at most ENUMERATE_LIMIT tiles are enumerated exactly, counting the consistent
+//     layouts for each number of mines they hold.
+//   - Larger ones are sampled: tiles are assigned in order, each uniformly among the values that keep
+//     every constraint satisfiable, and a finished layout is weighted by 2^(choices made) so the
+//     weighted counts estimate the same per-mine-count totals.
+// Components are then combined with the interior (undecided tiles next to no number) by weighting
+// each total of frontier mines by the ways the remaining mines fit in the interior.
+// Enumeration and sampling run as independent tasks over all cores. Each sampling task draws from its
+// own Rng stream derived from the seed and the task, so results do not depend on the thread count.
+class ProbabilityEngine {
+public:
+    enum {
+        ENUMERATE_LIMIT = 24,
+        SAMPLE_TASKS = 16,
+        SAMPLES_PER_TASK = 1024
+    };
+
+private:
+    // Undecided frontier tiles linked through shared constraints, in search order
+    struct Component {
+        std::vector<int> tiles;
+        // Per constraint: mines still needed, and how many of the component's tiles it covers
+        std::vector<int> need;
+        std::vector<int> width;
+        // Constraints around local tile t are tileConstraints[constraintStart[t] .. constraintStart[t + 1])
+        std::vector<int> constraintStart;
+        std::vector<int> tileConstraints;
+        bool sampled;
+    };
+
+    // Layout counts by number of mines, and per k how many of those layouts put a mine on each tile.
+    // Sampled weights are stored times 2^-scale so they stay in range.
+    struct Tally {
+        int scale;
+        std::vector<double> layouts;
+        std::vector<std::vector<double>> tileMines;
+    };
+
+    struct Task {
+        int component;
+        // 0 enumerates the whole component
+        int samples;
+        std::uint64_t stream;
+    };
+
+    int numThreads;
+    std::vector<Component> components;
+    std::vector<Task> tasks;
+    std::vector<Tally> tallies;
+    // Per board tile: constraint index of a revealed number, and local index within its component
+    std::vector<int> constraintAt;
+    std::vector<int> localIndex;
+
+    void buildComponents(const SolverInput& input, const SolverResult& known, int& interior);
+
+    void runTask(int task, const std::atomic<bool>& cancelled);
+
+    // Adds b into a, both for the same component
+    static void merge(Tally& a, const Tally& b);
+
+public:
+    // 0 threads uses every core
+    explicit ProbabilityEngine(int numThreads = 0);
+
+    // known is the solver's result for the same input; its decisions are taken as given.
+    // False if cancelled partway, in which case the result is incomplete.
+    bool estimate(const SolverInput& input, const SolverResult& known, ProbabilityResult& result,
+                  std::uint64_t seed, const std::atomic<bool>& cancelled);
+};
+
+#endif //MINESWEEPER_PROBABILITY_ENGINE_H
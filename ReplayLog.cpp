@@ -0,0 +1,369 @@
+#include <iterator> // std::istreambuf_iterator
+#include "ReplayLog.h"
+#include "file_read_exception.h"
+
+namespace {
+    enum recordTags : std::uint8_t {
+        // Action tags are the ReplayEvent types
+        keyframeTag = ReplayEvent::keyframe, indexTag
+    };
+
+    enum keyframeFlags : std::uint8_t {
+        minesPlacedFlag = 1, pausedFlag = 2, gameOverFlag = 4, gameWonFlag = 8
+    };
+
+    void putVarint(std::vector<std::uint8_t>& bytes, std::uint64_t value) {
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    std::uint64_t getVarint(const std::vector<std::uint8_t>& data, size_t& position) {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (position >= data.size()) {
+                throw file_read_exception("Replay file is truncated!");
+            }
+            std::uint8_t byte = data[position++];
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw file_read_exception("Replay file is corrupt!");
+    }
+
+    // One bit of every tile as alternating runs of clear and set tiles, starting with clear
+    void putPlane(std::vector<std::uint8_t>& bytes, const std::vector<std::uint8_t>& tiles, std::uint8_t bit) {
+        std::vector<std::uint64_t> runs;
+        bool set = false;
+        std::uint64_t run = 0;
+        for (std::uint8_t tile: tiles) {
+            if (((tile & bit) != 0) != set) {
+                runs.push_back(run);
+                set = !set;
+                run = 0;
+            }
+            run++;
+        }
+        runs.push_back(run);
+        putVarint(bytes, runs.size());
+        for (std::uint64_t length: runs) {
+            putVarint(bytes, length);
+        }
+    }
+
+    void getPlane(const std::vector<std::uint8_t>& data, size_t& position, std::vector<std::uint8_t>& tiles,
+                  std::uint8_t bit) {
+        std::uint64_t numRuns = getVarint(data, position);
+        size_t tile = 0;
+        bool set = false;
+        for (std::uint64_t i = 0; i < numRuns; i++) {
+            std::uint64_t length = getVarint(data, position);
+            if (length > tiles.size() - tile) {
+                throw file_read_exception("Replay file is corrupt!");
+            }
+            if (set) {
+                for (std::uint64_t j = 0; j < length; j++) {
+                    tiles[tile + j] = static_cast<std::uint8_t>(tiles[tile + j] | bit);
+                }
+            }
+            tile += length;
+            set = !set;
+        }
+    }
+}
+
+ReplayWriter::ReplayWriter() {
+    this->bytesWritten = 0;
+    this->recording = false;
+    this->lastTimeMs = 0;
+    this->eventsSinceKeyframe = 0;
+}
+
+ReplayWriter::~ReplayWriter() {
+    finish();
+}
+
+void ReplayWriter::write(const std::vector<std::uint8_t>& bytes) {
+    if (!out.is_open()) {
+        return;
+    }
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    bytesWritten += static_cast<long long>(bytes.size());
+}
+
+void ReplayWriter::begin(const std::string& path, const Board& board) {
+    finish();
+    recording = true;
+    startTime = std::chrono::steady_clock::now();
+    lastTimeMs = 0;
+    eventsSinceKeyframe = 0;
+
+    pending = {'M', 'S', 'R', '1'};
+    putVarint(pending, board.getSeed());
+    putVarint(pending, static_cast<std::uint64_t>(board.getGrid().getCols()));
+    putVarint(pending, static_cast<std::uint64_t>(board.getGrid().getRows()));
+    putVarint(pending, static_cast<std::uint64_t>(board.getMines()));
+    worker.submit([this, path]() {
+        out.open(path, std::ios::binary | std::ios::trunc);
+        if (!out.good()) {
+            out.close();
+        }
+        bytesWritten = 0;
+        keyframeTimes.clear();
+        keyframeOffsets.clear();
+    });
+    // Seeking always has somewhere to start from
+    queueKeyframe(board);
+}
+
+void ReplayWriter::queueKeyframe(const Board& board) {
+    // The worker gets the records and a copy of the board, and encodes the keyframe itself
+    std::shared_ptr<std::vector<std::uint8_t>> records = std::make_shared<std::vector<std::uint8_t>>();
+    records->swap(pending);
+    std::shared_ptr<BoardState> state = std::make_shared<BoardState>(board.saveState());
+    long long timeMs = lastTimeMs;
+    worker.submit([this, records, state, timeMs]() {
+        write(*records);
+        std::vector<std::uint8_t> bytes = {keyframeTag};
+        putVarint(bytes, static_cast<std::uint64_t>(timeMs));
+        putVarint(bytes, state->seed);
+        bytes.push_back(static_cast<std::uint8_t>((state->minesPlaced ? minesPlacedFlag : 0) |
+                                                  (state->paused ? pausedFlag : 0) |
+                                                  (state->gameOver ? gameOverFlag : 0) |
+                                                  (state->gameWon ? gameWonFlag : 0)));
+        putPlane(bytes, state->tiles, BoardState::mineBit);
+        putPlane(bytes, state->tiles, BoardState::revealedBit);
+        putPlane(bytes, state->tiles, BoardState::flaggedBit);
+        keyframeTimes.push_back(timeMs);
+        keyframeOffsets.push_back(bytesWritten);
+        write(bytes);
+    });
+    eventsSinceKeyframe = 0;
+}
+
+void ReplayWriter::record(int type, int col, int row, const Board& board) {
+    if (!recording) {
+        return;
+    }
+    long long nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+    pending.push_back(static_cast<std::uint8_t>(type));
+    putVarint(pending, static_cast<std::uint64_t>(nowMs - lastTimeMs));
+    if (type == ReplayEvent::reveal || type == ReplayEvent::flag) {
+        putVarint(pending, static_cast<std::uint64_t>(col));
+        putVarint(pending, static_cast<std::uint64_t>(row));
+    }
+    lastTimeMs = nowMs;
+    if (++eventsSinceKeyframe >= KEYFRAME_INTERVAL) {
+        queueKeyframe(board);
+    }
+}
+
+void ReplayWriter::finish() {
+    if (!recording) {
+        return;
+    }
+    recording = false;
+    std::shared_ptr<std::vector<std::uint8_t>> records = std::make_shared<std::vector<std::uint8_t>>();
+    records->swap(pending);
+    worker.submit([this, records]() {
+        if (!out.is_open()) {
+            return;
+        }
+        write(*records);
+        long long indexOffset = bytesWritten;
+        std::vector<std::uint8_t> bytes = {indexTag};
+        putVarint(bytes, keyframeTimes.size());
+        for (size_t i = 0; i < keyframeTimes.size(); i++) {
+            putVarint(bytes, static_cast<std::uint64_t>(keyframeTimes[i]));
+            putVarint(bytes, static_cast<std::uint64_t>(keyframeOffsets[i]));
+        }
+        for (int i = 0; i < 4; i++) {
+            bytes.push_back(static_cast<std::uint8_t>(static_cast<std::uint32_t>(indexOffset) >> (8 * i)));
+        }
+        bytes.insert(bytes.end(), {'M', 'S', 'R', 'X'});
+        write(bytes);
+        out.close();
+    });
+}
+
+ReplayReader::ReplayReader(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.good()) {
+        throw file_read_exception("Failed to open replay file!");
+    }
+    this->data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (data.size() < 4 || data[0] != 'M' || data[1] != 'S' || data[2] != 'R' || data[3] != '1') {
+        throw file_read_exception("Not a replay file!");
+    }
+    this->position = 4;
+    this->seed = getVarint(data, position);
+    this->cols = static_cast<int>(getVarint(data, position));
+    this->rows = static_cast<int>(getVarint(data, position));
+    this->mines = static_cast<int>(getVarint(data, position));
+    this->firstRecord = position;
+    this->timeMs = 0;
+    buildIndex();
+}
+
+std::uint64_t ReplayReader::getSeed() const {
+    return this->seed;
+}
+
+int ReplayReader::getCols() const {
+    return this->cols;
+}
+
+int ReplayReader::getRows() const {
+    return this->rows;
+}
+
+int ReplayReader::getMines() const {
+    return this->mines;
+}
+
+void ReplayReader::buildIndex() {
+    keyframeTimes.clear();
+    keyframeOffsets.clear();
+    size_t size = data.size();
+    if (size >= firstRecord + 8 && data[size - 4] == 'M' && data[size - 3] == 'S' && data[size - 2] == 'R' &&
+        data[size - 1] == 'X') {
+        size_t indexOffset = 0;
+        for (int i = 0; i < 4; i++) {
+            indexOffset |= static_cast<size_t>(data[size - 8 + i]) << (8 * i);
+        }
+        // Offsets count from the start of the file
+        size_t indexPosition = indexOffset;
+        if (indexPosition < size && data[indexPosition] == indexTag) {
+            indexPosition++;
+            std::uint64_t count = getVarint(data, indexPosition);
+            for (std::uint64_t i = 0; i < count; i++) {
+                keyframeTimes.push_back(static_cast<long long>(getVarint(data, indexPosition)));
+                keyframeOffsets.push_back(static_cast<size_t>(getVarint(data, indexPosition)));
+            }
+            return;
+        }
+    }
+    // Unfinished log (the game crashed or is still running): find the keyframes by scanning
+    size_t savedPosition = position;
+    long long savedTime = timeMs;
+    ReplayEvent event{};
+    position = firstRecord;
+    timeMs = 0;
+    size_t recordStart = position;
+    try {
+        while (next(event)) {
+            if (event.type == ReplayEvent::keyframe) {
+                keyframeTimes.push_back(event.timeMs);
+                keyframeOffsets.push_back(recordStart);
+            }
+            recordStart = position;
+        }
+    } catch (file_read_exception& e) {
+        // A record cut off mid-write; play everything before it
+        data.resize(recordStart);
+    }
+    position = savedPosition;
+    timeMs = savedTime;
+}
+
+void ReplayReader::readKeyframe() {
+    timeMs = static_cast<long long>(getVarint(data, position));
+    keyframe.seed = getVarint(data, position);
+    if (position >= data.size()) {
+        throw file_read_exception("Replay file is truncated!");
+    }
+    std::uint8_t flags = data[position++];
+    keyframe.minesPlaced = (flags & minesPlacedFlag) != 0;
+    keyframe.paused = (flags & pausedFlag) != 0;
+    keyframe.gameOver = (flags & gameOverFlag) != 0;
+    keyframe.gameWon = (flags & gameWonFlag) != 0;
+    keyframe.tiles.assign(static_cast<size_t>(cols) * static_cast<size_t>(rows), 0);
+    getPlane(data, position, keyframe.tiles, BoardState::mineBit);
+    getPlane(data, position, keyframe.tiles, BoardState::revealedBit);
+    getPlane(data, position, keyframe.tiles, BoardState::flaggedBit);
+}
+
+bool ReplayReader::next(ReplayEvent& event) {
+    if (position >= data.size() || data[position] == indexTag) {
+        return false;
+    }
+    std::uint8_t tag = data[position++];
+    event.type = tag;
+    event.col = 0;
+    event.row = 0;
+    if (tag == keyframeTag) {
+        readKeyframe();
+        event.timeMs = timeMs;
+        return true;
+    }
+    if (tag > ReplayEvent::reset) {
+        throw file_read_exception("Replay file is corrupt!");
+    }
+    timeMs += static_cast<long long>(getVarint(data, position));
+    event.timeMs = timeMs;
+    if (tag == ReplayEvent::reveal || tag == ReplayEvent::flag) {
+        event.col = static_cast<int>(getVarint(data, position));
+        event.row = static_cast<int>(getVarint(data, position));
+    }
+    return true;
+}
+
+const BoardState& ReplayReader::getKeyframe() const {
+    return this->keyframe;
+}
+
+void ReplayReader::seek(long long targetMs, Board& board) {
+    // Last keyframe at or before the target; the log always opens with one at time zero
+    size_t start = 0;
+    for (size_t i = 0; i < keyframeTimes.size() && keyframeTimes[i] <= targetMs; i++) {
+        start = i;
+    }
+    position = keyframeOffsets.empty() ? firstRecord : keyframeOffsets[start];
+    timeMs = 0;
+    ReplayEvent event{};
+    while (true) {
+        size_t recordStart = position;
+        long long recordTime = timeMs;
+        if (!next(event)) {
+            return;
+        }
+        if (event.timeMs > targetMs) {
+            // Leave the first action past the target for next()
+            position = recordStart;
+            timeMs = recordTime;
+            return;
+        }
+        if (event.type == ReplayEvent::keyframe) {
+            board.restoreState(keyframe);
+        } else {
+            apply(event, board);
+        }
+    }
+}
+
+void ReplayReader::apply(const ReplayEvent& event, Board& board) {
+    switch (event.type) {
+        case ReplayEvent::reveal:
+            board.reveal(event.col, event.row);
+            break;
+        case ReplayEvent::flag:
+            board.toggleFlag(event.col, event.row);
+            break;
+        case ReplayEvent::pause:
+            board.setPaused(true);
+            break;
+        case ReplayEvent::resume:
+            board.setPaused(false);
+            break;
+        case ReplayEvent::reset:
+            board.reset();
+            break;
+        default:
+            break;
+    }
+}
@@ -0,0 +1,130 @@
+#ifndef MINESWEEPER_REPLAY_LOG_H
+#define MINESWEEPER_REPLAY_LOG_H
+
+#include <chrono> // Event timestamps
+#include <cstdint> // Byte buffers and seeds
+#include <fstream> // Log file
+#include <memory> // std::shared_ptr to hand buffers to the writer thread
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "IoWorker.h"
+
+// Replay file layout (integers are unsigned LEB128 varints unless noted):
+//   "MSR1", seed, cols, rows, mines
+//   then records, each starting with a one-byte tag:
+//     reveal/flag:        tag, ms since the previous record, col, row
+//     pause/resume/reset: tag, ms since the previous record
+//     keyframe:           tag, absolute ms, seed, flags byte, then the mine, revealed and flagged
+//                         planes as run lengths (run count, then alternating clear/set runs)
+//     index:              tag, count, then (absolute ms, byte offset) of every keyframe
+//   and, once the log is finished, a trailer: u32 little-endian offset of the index, "MSRX".
+// A keyframe is the board state after every record before it, so seeking restores the last
+// keyframe at or before the target and replays only the actions after it.
+struct ReplayEvent {
+    enum types {
+        reveal, flag, pause, resume, reset, keyframe
+    };
+    int type;
+    long long timeMs;
+    int col;
+    int row;
+};
+
+// Records are encoded on the calling thread into a memory buffer; the file is opened, written and
+// closed by tasks on the writer's own IoWorker, so the game loop never waits on the disk.
+class ReplayWriter {
+private:
+    // Only touched by tasks on the worker
+    std::ofstream out;
+    long long bytesWritten;
+    // (time, offset) pairs for the index
+    std::vector<long long> keyframeTimes;
+    std::vector<long long> keyframeOffsets;
+
+    // Only touched by the calling thread
+    bool recording;
+    std::chrono::steady_clock::time_point startTime;
+    long long lastTimeMs;
+    int eventsSinceKeyframe;
+    // Records not yet handed to the worker
+    std::vector<std::uint8_t> pending;
+
+    // Declared last so it is destroyed first, finishing its queued writes while the state above lives
+    IoWorker worker;
+
+    // Worker side: appends to the file
+    void write(const std::vector<std::uint8_t>& bytes);
+
+    // Hands the pending records, then a keyframe of the board, to the worker
+    void queueKeyframe(const Board& board);
+
+public:
+    // A keyframe follows every this many actions
+    static const int KEYFRAME_INTERVAL = 64;
+
+    ReplayWriter();
+
+    ~ReplayWriter();
+
+    ReplayWriter(const ReplayWriter&) = delete;
+
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    // Starts a new log of a fresh board, replacing any file at path. The file is created in the
+    // background; if that fails, nothing is written until the next begin().
+    void begin(const std::string& path, const Board& board);
+
+    // Called by the board after it applies an action; board is its state afterwards
+    void record(int type, int col, int row, const Board& board);
+
+    // Queues the pending records, the seek index and closing the file; also done by the destructor,
+    // which waits for the queued writes
+    void finish();
+};
+
+class ReplayReader {
+private:
+    std::vector<std::uint8_t> data;
+    size_t position;
+    long long timeMs;
+    std::uint64_t seed;
+    int cols;
+    int rows;
+    int mines;
+    size_t firstRecord;
+    std::vector<long long> keyframeTimes;
+    std::vector<size_t> keyframeOffsets;
+    BoardState keyframe;
+
+    // Reads the trailer's index, or scans the records if the log was never finished
+    void buildIndex();
+
+    void readKeyframe();
+
+public:
+    // Throws file_read_exception if the file is missing or not a replay
+    explicit ReplayReader(const std::string& path);
+
+    std::uint64_t getSeed() const;
+
+    int getCols() const;
+
+    int getRows() const;
+
+    int getMines() const;
+
+    // Next record in file order, keyframes included; false at the end of the log
+    bool next(ReplayEvent& event);
+
+    // State stored by the keyframe next() most recently returned
+    const BoardState& getKeyframe() const;
+
+    // Puts the board in its state at timeMs via the nearest keyframe; next() then continues from there
+    void seek(long long timeMs, Board& board);
+
+    // Replays one action on the board; keyframes are ignored
+    static void apply(const ReplayEvent& event, Board& board);
+};
+
+#endif //MINESWEEPER_REPLAY_LOG_H
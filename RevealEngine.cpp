@@ -0,0 +1,43 @@
+#include "RevealEngine.h"
+
+RevealEngine::RevealEngine() {
+    this->pending = {};
+    this->changed = {};
+}
+
+const std::vector<int>& RevealEngine::reveal(TileGrid& grid, int index) {
+    changed.clear();
+    pending.clear();
+    if (grid.isMine(index) || grid.isFlagged(index)) {
+        return changed;
+    }
+    if (!grid.isRevealed(index)) {
+        grid.setRevealed(index, true);
+        changed.push_back(index);
+    }
+    pending.push_back(index);
+
+    int neighbors[8];
+    while (!pending.empty()) {
+        int current = pending.back();
+        pending.pop_back();
+        // Stop spreading at numbered tiles and next to flags
+        if (grid.countMineNeighbors(current) != 0 || grid.countFlagNeighbors(current) != 0) {
+            continue;
+        }
+        int numNeighbors = grid.getNeighbors(current, neighbors);
+        for (int i = 0; i < numNeighbors; i++) {
+            int neighbor = neighbors[i];
+            if (grid.isRevealed(neighbor)) {
+                continue;
+            }
+            grid.setRevealed(neighbor, true);
+            changed.push_back(neighbor);
+            // Each tile is pushed at most once: only when it is first revealed
+            if (grid.countMineNeighbors(neighbor) == 0) {
+                pending.push_back(neighbor);
+            }
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,22 @@
+#ifndef MINESWEEPER_REVEAL_ENGINE_H
+#define MINESWEEPER_REVEAL_ENGINE_H
+
+#include <vector> // Reusable work and result buffers
+#include "TileGrid.h"
+
+// Iterative flood-fill reveal. The work stack and change list keep their capacity between
+// calls, so a reveal of any size does no per-tile allocation and cannot overflow the call stack.
+class RevealEngine {
+private:
+    std::vector<int> pending;
+    std::vector<int> changed;
+
+public:
+    RevealEngine();
+
+    // Reveal the tile and flood through zero tiles; returns the indices of every tile it revealed.
+    // The returned list stays valid until the next call.
+    const std::vector<int>& reveal(TileGrid& grid, int index);
+};
+
+#endif //MINESWEEPER_REVEAL_ENGINE_H
@@ -0,0 +1,66 @@
+#include <chrono> // Clock bits for randomSeed
+#include <random> // std::random_device for randomSeed
+#include "Rng.h"
+
+namespace {
+    std::uint64_t rotateLeft(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    // splitmix64's output function
+    std::uint64_t mix(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t splitmix64(std::uint64_t& x) {
+        return mix(x += 0x9e3779b97f4a7c15ULL);
+    }
+}
+
+Rng::Rng(std::uint64_t seed) {
+    // Spreads even small or similar seeds over the whole state, which must not be all zero
+    for (std::uint64_t& word: state) {
+        word = splitmix64(seed);
+    }
+}
+
+std::uint64_t Rng::next() {
+    std::uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+    std::uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotateLeft(state[3], 45);
+    return result;
+}
+
+int Rng::uniform(int low, int high) {
+    // Lemire's multiply-and-shift, rejecting only the few values that would bias the result
+    std::uint32_t range = static_cast<std::uint32_t>(static_cast<std::int64_t>(high) - low + 1);
+    std::uint64_t product = static_cast<std::uint64_t>(next() >> 32) * range;
+    std::uint32_t leftover = static_cast<std::uint32_t>(product);
+    if (leftover < range) {
+        std::uint32_t threshold = (0u - range) % range;
+        while (leftover < threshold) {
+            product = static_cast<std::uint64_t>(next() >> 32) * range;
+            leftover = static_cast<std::uint32_t>(product);
+        }
+    }
+    return static_cast<int>(static_cast<std::int64_t>(low) + static_cast<std::int64_t>(product >> 32));
+}
+
+std::uint64_t Rng::hash(std::uint64_t x) {
+    // Stepping by the golden ratio first keeps consecutive inputs far apart, as splitmix64 does
+    return mix(x * 0x9e3779b97f4a7c15ULL + 0x9e3779b97f4a7c15ULL);
+}
+
+std::uint64_t Rng::randomSeed() {
+    std::random_device device;
+    std::uint64_t seed = (static_cast<std::uint64_t>(device()) << 32) ^ device();
+    // Some standard libraries implement random_device as a fixed sequence, so mix in the clock too
+    return seed ^ static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+}
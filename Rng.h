@@ -0,0 +1,29 @@
+#ifndef MINESWEEPER_RNG_H
+#define MINESWEEPER_RNG_H
+
+#include <cstdint> // Fixed-width state so every platform produces the same stream
+
+// xoshiro256** seeded through splitmix64: 32 bytes of state, a few cycles per draw.
+// Bounded draws use integer arithmetic only, so a seed gives bit-identical boards on every machine
+// (std::uniform_int_distribution is implementation-defined and differs between standard libraries).
+class Rng {
+private:
+    std::uint64_t state[4];
+
+public:
+    explicit Rng(std::uint64_t seed);
+
+    std::uint64_t next();
+
+    // Uniform in [low, high]
+    int uniform(int low, int high);
+
+    // Stateless counter-based hash: well-mixed output for any input, so hash(key + i) is a random
+    // stream that can be read at any position without generating what comes before it
+    static std::uint64_t hash(std::uint64_t x);
+
+    // Fresh seed for when none was configured
+    static std::uint64_t randomSeed();
+};
+
+#endif //MINESWEEPER_RNG_H
@@ -0,0 +1,123 @@
+#include <algorithm> // std::min, std::max
+#include <chrono> // Throughput timing
+#include <memory> // std::unique_ptr for each worker's Strategy
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Board.h"
+#include "Simulator.h"
+#include "Strategy.h"
+
+namespace {
+    // Game numbers a worker has yet to play. Padded so neighboring workers' locks never share a cache line.
+    struct WorkRange {
+        std::mutex mutex;
+        long long next;
+        long long end;
+        char padding[64];
+    };
+
+    bool takeGame(WorkRange& range, long long& game) {
+        std::lock_guard<std::mutex> lock(range.mutex);
+        if (range.next >= range.end) {
+            return false;
+        }
+        game = range.next++;
+        return true;
+    }
+
+    // Moves the upper half of the victim's remaining games (at least one) into the thief's empty range
+    bool steal(WorkRange& thief, WorkRange& victim, long long& game) {
+        long long first;
+        long long end;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            long long remaining = victim.end - victim.next;
+            if (remaining <= 0) {
+                return false;
+            }
+            first = victim.end - (remaining + 1) / 2;
+            end = victim.end;
+            victim.end = first;
+        }
+        std::lock_guard<std::mutex> lock(thief.mutex);
+        game = first;
+        thief.next = first + 1;
+        thief.end = end;
+        return true;
+    }
+}
+
+Simulator::Simulator(int cols, int rows, int mines, const std::string& strategyName, int numThreads) {
+    this->cols = cols;
+    this->rows = rows;
+    this->mines = mines;
+    this->strategyName = strategyName;
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    this->numThreads = numThreads > 0 ? numThreads : 1;
+}
+
+SimulationReport Simulator::run(long long games, std::uint64_t firstSeed) const {
+    int threads = static_cast<int>(std::max(1LL, std::min(static_cast<long long>(numThreads), games)));
+    std::vector<WorkRange> ranges(static_cast<size_t>(threads));
+    for (int w = 0; w < threads; w++) {
+        ranges[w].next = games * w / threads;
+        ranges[w].end = games * (w + 1) / threads;
+    }
+    std::vector<SimulationReport> totals(static_cast<size_t>(threads));
+
+    auto work = [&](int w) {
+        // Built on the worker's own thread, so its memory is local to the core that uses it
+        Board board(std::make_pair(cols, rows), mines, firstSeed);
+        std::unique_ptr<Strategy> strategy = Strategy::create(strategyName);
+        long long played = 0;
+        long long wins = 0;
+        long long clicks = 0;
+        long long game;
+        while (true) {
+            bool hasGame = takeGame(ranges[w], game);
+            for (int offset = 1; offset < threads && !hasGame; offset++) {
+                hasGame = steal(ranges[w], ranges[(w + offset) % threads], game);
+            }
+            if (!hasGame) {
+                break;
+            }
+            board.reset(firstSeed + static_cast<std::uint64_t>(game));
+            strategy->newGame(board);
+            int col;
+            int row;
+            while (!board.isGameOver() && strategy->nextMove(board, col, row)) {
+                std::uint64_t revision = board.getRevision();
+                board.reveal(col, row);
+                clicks++;
+                // A move that changes nothing would be repeated forever
+                if (board.getRevision() == revision) {
+                    break;
+                }
+            }
+            played++;
+            wins += board.isGameWon() ? 1 : 0;
+        }
+        totals[w] = SimulationReport{played, wins, clicks, 1, 0};
+    };
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int w = 1; w < threads; w++) {
+        workers.push_back(std::thread(work, w));
+    }
+    work(0);
+    for (std::thread& worker: workers) {
+        worker.join();
+    }
+    SimulationReport report{0, 0, 0, threads,
+                            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+    for (const SimulationReport& total: totals) {
+        report.games += total.games;
+        report.wins += total.wins;
+        report.clicks += total.clicks;
+    }
+    return report;
+}
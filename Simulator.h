@@ -0,0 +1,36 @@
+#ifndef MINESWEEPER_SIMULATOR_H
+#define MINESWEEPER_SIMULATOR_H
+
+#include <cstdint>
+#include <string>
+
+struct SimulationReport {
+    long long games;
+    long long wins;
+    // Reveals made, including the losing one
+    long long clicks;
+    int threads;
+    double seconds;
+};
+
+// Plays many headless games with one Strategy per worker thread. Each worker owns a Board and a
+// Strategy, reused for every game it plays, and a range of game numbers; game g always uses seed
+// firstSeed + g, so the totals do not depend on the thread count or on which worker plays which game.
+// A worker that runs out steals the upper half of another worker's remaining range. Counts are
+// kept in locals and written out once at the end, so workers share nothing while playing.
+class Simulator {
+private:
+    int cols;
+    int rows;
+    int mines;
+    std::string strategyName;
+    int numThreads;
+
+public:
+    // strategyName must be one Strategy::create() knows; 0 threads uses every core
+    Simulator(int cols, int rows, int mines, const std::string& strategyName, int numThreads);
+
+    SimulationReport run(long long games, std::uint64_t firstSeed) const;
+};
+
+#endif //MINESWEEPER_SIMULATOR_H
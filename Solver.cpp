@@ -0,0 +1,221 @@
+#include <bitset> // Portable popcount
+#include "Solver.h"
+
+namespace {
+    int popcount(std::uint64_t mask) {
+        return static_cast<int>(std::bitset<64>(mask).count());
+    }
+
+    // A 3x3 mask moved into the 7x7 frame centered on another constraint, dx/dy from that center
+    std::uint64_t toFrame(std::uint16_t mask, int dx, int dy) {
+        std::uint64_t frame = 0;
+        for (int bit = 0; bit < 9; bit++) {
+            if ((mask >> bit & 1) != 0) {
+                int frameCol = bit % 3 + 2 + dx;
+                int frameRow = bit / 3 + 2 + dy;
+                frame |= std::uint64_t(1) << (frameRow * 7 + frameCol);
+            }
+        }
+        return frame;
+    }
+}
+
+void SolverInput::capture(const Board& board) {
+    const TileGrid& grid = board.getGrid();
+    this->cols = grid.getCols();
+    this->rows = grid.getRows();
+    this->totalMines = board.getMines() < grid.size() ? board.getMines() : grid.size();
+    this->revision = board.getRevision();
+    tiles.resize(static_cast<size_t>(grid.size()));
+    for (int i = 0; i < grid.size(); i++) {
+        tiles[i] = static_cast<std::int8_t>(grid.isRevealed(i) ? grid.countMineNeighbors(i) : HIDDEN);
+    }
+}
+
+Solver::Solver() {
+    this->input = nullptr;
+    this->safe = nullptr;
+    this->mines = nullptr;
+}
+
+int Solver::tileOfBit(int center, int bit) const {
+    return center + (bit / 3 - 1) * input->cols + (bit % 3 - 1);
+}
+
+void Solver::decide(int tile, bool isMine) {
+    if (safe->test(tile) || mines->test(tile)) {
+        return;
+    }
+    if (isMine) {
+        mines->set(tile);
+    } else {
+        safe->set(tile);
+    }
+    // Take the tile out of every constraint around it
+    int col = tile % input->cols;
+    int row = tile / input->cols;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int centerCol = col + dx;
+            int centerRow = row + dy;
+            if (centerCol < 0 || centerCol >= input->cols || centerRow < 0 || centerRow >= input->rows) {
+                continue;
+            }
+            int index = constraintAt[centerRow * input->cols + centerCol];
+            if (index == -1) {
+                continue;
+            }
+            Constraint& constraint = constraints[index];
+            // The tile is at (-dx, -dy) from this center
+            constraint.mask = static_cast<std::uint16_t>(constraint.mask & ~(1 << ((1 - dy) * 3 + (1 - dx))));
+            if (isMine) {
+                constraint.minesNeeded--;
+            }
+            pending.push_back(index);
+        }
+    }
+}
+
+void Solver::propagate() {
+    while (!pending.empty()) {
+        Constraint constraint = constraints[pending.back()];
+        pending.pop_back();
+        if (constraint.mask == 0) {
+            continue;
+        }
+        int undecided = popcount(constraint.mask);
+        // Anything else is a contradiction, which a real board cannot produce
+        if (constraint.minesNeeded != 0 && constraint.minesNeeded != undecided) {
+            continue;
+        }
+        bool allMines = constraint.minesNeeded == undecided;
+        for (int bit = 0; bit < 9; bit++) {
+            if ((constraint.mask >> bit & 1) != 0) {
+                decide(tileOfBit(constraint.center, bit), allMines);
+            }
+        }
+    }
+}
+
+bool Solver::reducePairs(const std::atomic<bool>& cancelled) {
+    bool progress = false;
+    for (size_t a = 0; a < constraints.size(); a++) {
+        if (cancelled.load(std::memory_order_relaxed)) {
+            return progress;
+        }
+        if (constraints[a].mask == 0) {
+            continue;
+        }
+        int centerCol = constraints[a].center % input->cols;
+        int centerRow = constraints[a].center / input->cols;
+        for (int dy = -2; dy <= 2; dy++) {
+            for (int dx = -2; dx <= 2; dx++) {
+                int col = centerCol + dx;
+                int row = centerRow + dy;
+                if ((dx == 0 && dy == 0) || col < 0 || col >= input->cols || row < 0 || row >= input->rows) {
+                    continue;
+                }
+                int b = constraintAt[row * input->cols + col];
+                // Re-read A: a deduction from an earlier pair may have shrunk it
+                const Constraint& first = constraints[a];
+                if (b == -1 || first.mask == 0 || constraints[b].mask == 0) {
+                    continue;
+                }
+                const Constraint& second = constraints[b];
+                std::uint64_t frameA = toFrame(first.mask, 0, 0);
+                std::uint64_t frameB = toFrame(second.mask, dx, dy);
+                if ((frameA & frameB) == 0) {
+                    continue;
+                }
+                std::uint64_t onlyA = frameA & ~frameB;
+                std::uint64_t onlyB = frameB & ~frameA;
+                // Identical masks decide nothing; B inside A (onlyB empty) is the subset rule
+                if ((onlyA | onlyB) == 0 || second.minesNeeded - first.minesNeeded != popcount(onlyB)) {
+                    continue;
+                }
+                // Copy the center before decide() touches the constraints
+                int center = first.center;
+                for (int bit = 0; bit < 49; bit++) {
+                    std::uint64_t flag = std::uint64_t(1) << bit;
+                    if ((onlyA & flag) == 0 && (onlyB & flag) == 0) {
+                        continue;
+                    }
+                    int tile = center + (bit / 7 - 3) * input->cols + (bit % 7 - 3);
+                    decide(tile, (onlyB & flag) != 0);
+                }
+                propagate();
+                progress = true;
+            }
+        }
+    }
+    return progress;
+}
+
+bool Solver::applyMineCount() {
+    int hidden = 0;
+    for (std::int8_t tile: input->tiles) {
+        if (tile == SolverInput::HIDDEN) {
+            hidden++;
+        }
+    }
+    int minesLeft = input->totalMines - mines->count();
+    int undecided = hidden - mines->count() - safe->count();
+    if (undecided == 0 || (minesLeft != 0 && minesLeft != undecided)) {
+        return false;
+    }
+    for (int i = 0; i < static_cast<int>(input->tiles.size()); i++) {
+        if (input->tiles[i] == SolverInput::HIDDEN) {
+            decide(i, minesLeft != 0);
+        }
+    }
+    propagate();
+    return true;
+}
+
+bool Solver::solve(const SolverInput& solverInput, SolverResult& result, const std::atomic<bool>& cancelled) {
+    this->input = &solverInput;
+    this->safe = &result.safe;
+    this->mines = &result.mines;
+    int size = static_cast<int>(solverInput.tiles.size());
+    result.revision = solverInput.revision;
+    result.safe.reset(size);
+    result.mines.reset(size);
+    constraints.clear();
+    pending.clear();
+    constraintAt.assign(static_cast<size_t>(size), -1);
+
+    // One constraint per revealed number with hidden neighbors
+    for (int i = 0; i < size; i++) {
+        int number = solverInput.tiles[i];
+        if (number == SolverInput::HIDDEN) {
+            continue;
+        }
+        int col = i % solverInput.cols;
+        int row = i / solverInput.cols;
+        Constraint constraint{i, 0, number};
+        for (int bit = 0; bit < 9; bit++) {
+            int neighborCol = col + bit % 3 - 1;
+            int neighborRow = row + bit / 3 - 1;
+            if (bit == 4 || neighborCol < 0 || neighborCol >= solverInput.cols || neighborRow < 0 ||
+                neighborRow >= solverInput.rows) {
+                continue;
+            }
+            if (solverInput.tiles[neighborRow * solverInput.cols + neighborCol] == SolverInput::HIDDEN) {
+                constraint.mask = static_cast<std::uint16_t>(constraint.mask | (1 << bit));
+            }
+        }
+        if (constraint.mask != 0) {
+            constraintAt[i] = static_cast<int>(constraints.size());
+            pending.push_back(static_cast<int>(constraints.size()));
+            constraints.push_back(constraint);
+        }
+    }
+
+    propagate();
+    while (!cancelled.load(std::memory_order_relaxed)) {
+        if (!reducePairs(cancelled) && !applyMineCount()) {
+            break;
+        }
+    }
+    return !cancelled.load(std::memory_order_relaxed);
+}
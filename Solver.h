@@ -0,0 +1,80 @@
+#ifndef MINESWEEPER_SOLVER_H
+#define MINESWEEPER_SOLVER_H
+
+#include <atomic> // Cancellation flag shared with the UI thread
+#include <cstdint>
+#include <vector>
+#include "Board.h"
+#include "TileBitset.h"
+
+// What a player can see: the only input the solver gets, so it can never peek at the mines
+struct SolverInput {
+    // Tiles that are not revealed; flags are the player's guesses and are not trusted
+    enum {
+        HIDDEN = -1
+    };
+    int cols;
+    int rows;
+    int totalMines;
+    // Board revision this was captured from
+    std::uint64_t revision;
+    // HIDDEN, or the revealed tile's adjacent mine count
+    std::vector<std::int8_t> tiles;
+
+    void capture(const Board& board);
+};
+
+struct SolverResult {
+    std::uint64_t revision;
+    // Hidden tiles that are certainly safe, and certainly mines
+    TileBitset safe;
+    TileBitset mines;
+};
+
+// Deterministic constraint propagation over the revealed numbers. Each numbered tile with hidden
+// neighbors is a constraint: a 9-bit mask of its undecided neighbors and how many of them are mines.
+//   1. Single-point rules: no mines left means every neighbor is safe; as many mines as undecided
+//      neighbors means every one is a mine. Each decision updates the constraints around the tile.
+//   2. Pair reduction: for constraints A and B whose centers are at most 2 apart, compared as
+//      bitmasks in a shared 7x7 frame, if B needs exactly |B \ A| more mines than A then every tile of
+//      B \ A is a mine and every tile of A \ B is safe. With B \ A empty this is the subset rule: B
+//      inside A with as many mines leaves A \ B safe (the 1-1 pattern). With A \ B empty, B's extra
+//      mines fill B \ A (the 1-2 pattern).
+//   3. Global count: once all mines are accounted for (or every undecided tile must be one), the rest follow.
+// Steps repeat until nothing changes. Buffers are kept between calls.
+class Solver {
+private:
+    struct Constraint {
+        int center;
+        // Undecided neighbors, bit (dy + 1) * 3 + (dx + 1)
+        std::uint16_t mask;
+        int minesNeeded;
+    };
+
+    const SolverInput* input;
+    std::vector<Constraint> constraints;
+    // Constraint index of each numbered tile, or -1
+    std::vector<int> constraintAt;
+    std::vector<int> pending;
+    TileBitset* safe;
+    TileBitset* mines;
+
+    int tileOfBit(int center, int bit) const;
+
+    void decide(int tile, bool isMine);
+
+    void propagate();
+
+    // Returns true if it decided anything
+    bool reducePairs(const std::atomic<bool>& cancelled);
+
+    bool applyMineCount();
+
+public:
+    Solver();
+
+    // False if cancelled partway, in which case the result is incomplete
+    bool solve(const SolverInput& input, SolverResult& result, const std::atomic<bool>& cancelled);
+};
+
+#endif //MINESWEEPER_SOLVER_H
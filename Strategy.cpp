@@ -0,0 +1,136 @@
+#include <atomic>
+#include <vector>
+#include "ProbabilityEngine.h"
+#include "Rng.h"
+#include "Solver.h"
+#include "Strategy.h"
+
+namespace {
+    // Guesses use their own stream; the board's seed alone would replay the mine sampler's draws
+    const std::uint64_t GUESS_STREAM = 0x6a09e667f3bcc909ULL;
+
+    // Every strategy opens in the centre, which the first reveal always clears
+    bool openingMove(const Board& board, int& col, int& row) {
+        if (board.getRevealed() != 0) {
+            return false;
+        }
+        col = board.getGrid().getCols() / 2;
+        row = board.getGrid().getRows() / 2;
+        return true;
+    }
+
+    // Uniform over hidden tiles, skipping any in avoid (which may be empty)
+    bool randomHidden(const Board& board, Rng& rng, const TileBitset& avoid, int& col, int& row) {
+        const TileGrid& grid = board.getGrid();
+        if (board.getSafeRemaining() == 0) {
+            return false;
+        }
+        // A safe tile is always hidden, so this ends
+        while (true) {
+            int index = rng.uniform(0, grid.size() - 1);
+            if (!grid.isRevealed(index) && (avoid.size() == 0 || !avoid.test(index))) {
+                col = grid.colOf(index);
+                row = grid.rowOf(index);
+                return true;
+            }
+        }
+    }
+
+    class RandomStrategy : public Strategy {
+    private:
+        Rng rng;
+        TileBitset none;
+
+    public:
+        RandomStrategy() : rng(0) {
+        }
+
+        void newGame(const Board& board) override {
+            rng = Rng(board.getSeed() ^ GUESS_STREAM);
+        }
+
+        bool nextMove(const Board& board, int& col, int& row) override {
+            return openingMove(board, col, row) || randomHidden(board, rng, none, col, row);
+        }
+    };
+
+    // Reveals everything the solver proves safe; when it is stuck, guesses at random or by lowest mine chance
+    class SolverStrategy : public Strategy {
+    private:
+        bool guessSafest;
+        Rng rng;
+        Solver solver;
+        SolverInput input;
+        SolverResult known;
+        // Single-threaded: the simulator already runs one game per core
+        ProbabilityEngine probabilityEngine;
+        ProbabilityResult probabilities;
+        std::atomic<bool> cancelled;
+        // Proven safe by the last solve and not yet revealed
+        std::vector<int> safeTiles;
+
+    public:
+        explicit SolverStrategy(bool guessSafest) : rng(0), probabilityEngine(1), cancelled(false) {
+            this->guessSafest = guessSafest;
+        }
+
+        void newGame(const Board& board) override {
+            rng = Rng(board.getSeed() ^ GUESS_STREAM);
+            safeTiles.clear();
+        }
+
+        bool nextMove(const Board& board, int& col, int& row) override {
+            if (openingMove(board, col, row)) {
+                return true;
+            }
+            const TileGrid& grid = board.getGrid();
+            // Re-solve only once the last solve's safe tiles are used up; a flood fill may have opened some
+            while (true) {
+                while (!safeTiles.empty()) {
+                    int index = safeTiles.back();
+                    safeTiles.pop_back();
+                    if (!grid.isRevealed(index)) {
+                        col = grid.colOf(index);
+                        row = grid.rowOf(index);
+                        return true;
+                    }
+                }
+                if (input.revision == board.getRevision() && input.tiles.size() == static_cast<size_t>(grid.size())) {
+                    break;
+                }
+                input.capture(board);
+                solver.solve(input, known, cancelled);
+                for (int i = 0; i < grid.size(); i++) {
+                    if (known.safe.test(i)) {
+                        safeTiles.push_back(i);
+                    }
+                }
+            }
+            if (!guessSafest) {
+                return randomHidden(board, rng, known.mines, col, row);
+            }
+            // Seeded from the game and its progress only, so a game plays the same on whichever worker runs it
+            probabilityEngine.estimate(input, known, probabilities, board.getSeed() ^ board.getRevealed(), cancelled);
+            int index = probabilities.safestTile();
+            if (index == -1) {
+                return false;
+            }
+            col = grid.colOf(index);
+            row = grid.rowOf(index);
+            return true;
+        }
+    };
+}
+
+std::unique_ptr<Strategy> Strategy::create(const std::string& name) {
+    if (name == "random") {
+        return std::unique_ptr<Strategy>(new RandomStrategy());
+    }
+    if (name == "solver") {
+        return std::unique_ptr<Strategy>(new SolverStrategy(false));
+    }
+    if (name == "probability") {
+        return std::unique_ptr<Strategy>(new SolverStrategy(true));
+    }
+    return nullptr;
+}
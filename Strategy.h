@@ -0,0 +1,25 @@
+#ifndef MINESWEEPER_STRATEGY_H
+#define MINESWEEPER_STRATEGY_H
+
+#include <memory> // Owning factory result
+#include <string>
+#include "Board.h"
+
+// A way of playing a game, used by the Simulator. Sees the board only through what a player can see.
+// One instance plays one game at a time, so it may keep buffers and per-game state between moves.
+class Strategy {
+public:
+    virtual ~Strategy() = default;
+
+    // Called before the first move of each game
+    virtual void newGame(const Board& board) = 0;
+
+    // The next tile to reveal; false to give up
+    virtual bool nextMove(const Board& board, int& col, int& row) = 0;
+
+    // "random", "solver" (solver moves, random guesses) or "probability" (solver moves, safest guesses).
+    // Null for an unknown name.
+    static std::unique_ptr<Strategy> create(const std::string& name);
+};
+
+#endif //MINESWEEPER_STRATEGY_H
@@ -0,0 +1,37 @@
+#include <algorithm> // std::fill
+#include <bitset> // Portable popcount
+#include "TileBitset.h"
+
+TileBitset::TileBitset() {
+    this->numBits = 0;
+}
+
+void TileBitset::reset(int size) {
+    this->numBits = size;
+    words.resize(static_cast<size_t>((size + 63) / 64));
+    std::fill(words.begin(), words.end(), 0);
+}
+
+int TileBitset::size() const {
+    return this->numBits;
+}
+
+bool TileBitset::test(int index) const {
+    return (words[index >> 6] >> (index & 63) & 1) != 0;
+}
+
+void TileBitset::set(int index) {
+    words[index >> 6] |= std::uint64_t(1) << (index & 63);
+}
+
+int TileBitset::count() const {
+    int total = 0;
+    for (std::uint64_t word: words) {
+        total += static_cast<int>(std::bitset<64>(word).count());
+    }
+    return total;
+}
+
+bool TileBitset::operator==(const TileBitset& other) const {
+    return numBits == other.numBits && words == other.words;
+}
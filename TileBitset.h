@@ -0,0 +1,30 @@
+#ifndef MINESWEEPER_TILE_BITSET_H
+#define MINESWEEPER_TILE_BITSET_H
+
+#include <cstdint> // 64-bit words
+#include <vector>
+
+// One bit per tile index, packed 64 to a word
+class TileBitset {
+private:
+    std::vector<std::uint64_t> words;
+    int numBits;
+
+public:
+    TileBitset();
+
+    // Resizes to size bits, all clear; keeps its capacity
+    void reset(int size);
+
+    int size() const;
+
+    bool test(int index) const;
+
+    void set(int index);
+
+    int count() const;
+
+    bool operator==(const TileBitset& other) const;
+};
+
+#endif //MINESWEEPER_TILE_BITSET_H
@@ -0,0 +1,218 @@
+#include <algorithm> // std::fill
+#include "TileGrid.h"
+
+TileGrid::TileGrid() {
+    this->cols = 0;
+    this->rows = 0;
+    this->numMines = 0;
+    this->numRevealed = 0;
+    this->numFlagged = 0;
+    this->numRevealedSafe = 0;
+    this->allDirty = true;
+}
+
+TileGrid::TileGrid(int cols, int rows) {
+    this->cols = cols;
+    this->rows = rows;
+    this->cells.assign(static_cast<size_t>(cols) * static_cast<size_t>(rows), 0);
+    this->numMines = 0;
+    this->numRevealed = 0;
+    this->numFlagged = 0;
+    this->numRevealedSafe = 0;
+    this->allDirty = true;
+}
+
+int TileGrid::getCols() const {
+    return this->cols;
+}
+
+int TileGrid::getRows() const {
+    return this->rows;
+}
+
+int TileGrid::size() const {
+    return static_cast<int>(this->cells.size());
+}
+
+int TileGrid::index(int col, int row) const {
+    return row * cols + col;
+}
+
+int TileGrid::colOf(int index) const {
+    return index % cols;
+}
+
+int TileGrid::rowOf(int index) const {
+    return index / cols;
+}
+
+bool TileGrid::inBounds(int col, int row) const {
+    return col >= 0 && col < cols && row >= 0 && row < rows;
+}
+
+bool TileGrid::isMine(int index) const {
+    return (cells[index] & MINE) != 0;
+}
+
+bool TileGrid::isRevealed(int index) const {
+    return (cells[index] & REVEALED) != 0;
+}
+
+bool TileGrid::isFlagged(int index) const {
+    return (cells[index] & FLAGGED) != 0;
+}
+
+void TileGrid::setMine(int index, bool mine) {
+    if (!setBit(index, MINE, mine)) {
+        return;
+    }
+    numMines += mine ? 1 : -1;
+    if (isRevealed(index)) {
+        numRevealedSafe += mine ? -1 : 1;
+    }
+    // Increment or decrement the neighborhood's adjacency counts
+    int neighbors[8];
+    int numNeighbors = getNeighbors(index, neighbors);
+    for (int i = 0; i < numNeighbors; i++) {
+        std::uint8_t& cell = cells[neighbors[i]];
+        cell = static_cast<std::uint8_t>(mine ? cell + ADJACENT_ONE : cell - ADJACENT_ONE);
+        markDirty(neighbors[i]);
+    }
+}
+
+void TileGrid::fillMines() {
+    for (int row = 0; row < rows; row++) {
+        int spanRows = 1 + (row > 0 ? 1 : 0) + (row < rows - 1 ? 1 : 0);
+        for (int col = 0; col < cols; col++) {
+            // Every neighbor is a mine, so the count is just how many neighbors are on the board
+            int spanCols = 1 + (col > 0 ? 1 : 0) + (col < cols - 1 ? 1 : 0);
+            int adjacent = spanCols * spanRows - 1;
+            std::uint8_t& cell = cells[index(col, row)];
+            cell = static_cast<std::uint8_t>((cell & (REVEALED | FLAGGED)) | MINE | (adjacent << ADJACENT_SHIFT));
+        }
+    }
+    dirtyTiles.clear();
+    this->allDirty = true;
+    this->numMines = size();
+    this->numRevealedSafe = 0;
+}
+
+void TileGrid::setRevealed(int index, bool revealed) {
+    if (!setBit(index, REVEALED, revealed)) {
+        return;
+    }
+    numRevealed += revealed ? 1 : -1;
+    if (!isMine(index)) {
+        numRevealedSafe += revealed ? 1 : -1;
+    }
+}
+
+void TileGrid::setFlagged(int index, bool flagged) {
+    if (setBit(index, FLAGGED, flagged)) {
+        numFlagged += flagged ? 1 : -1;
+    }
+}
+
+bool TileGrid::setBit(int index, std::uint8_t bit, bool value) {
+    if (((cells[index] & bit) != 0) == value) {
+        return false;
+    }
+    if (value) {
+        cells[index] = static_cast<std::uint8_t>(cells[index] | bit);
+    } else {
+        cells[index] = static_cast<std::uint8_t>(cells[index] & ~bit);
+    }
+    markDirty(index);
+    return true;
+}
+
+int TileGrid::getNeighbors(int index, int (&neighbors)[8]) const {
+    int col = colOf(index);
+    int row = rowOf(index);
+    bool hasLeft = col > 0;
+    bool hasRight = col < cols - 1;
+    bool hasTop = row > 0;
+    bool hasBottom = row < rows - 1;
+    int numNeighbors = 0;
+    // Same order as the pos enum
+    if (hasTop && hasLeft) { neighbors[numNeighbors++] = index - cols - 1; }
+    if (hasTop) { neighbors[numNeighbors++] = index - cols; }
+    if (hasTop && hasRight) { neighbors[numNeighbors++] = index - cols + 1; }
+    if (hasLeft) { neighbors[numNeighbors++] = index - 1; }
+    if (hasRight) { neighbors[numNeighbors++] = index + 1; }
+    if (hasBottom && hasLeft) { neighbors[numNeighbors++] = index + cols - 1; }
+    if (hasBottom) { neighbors[numNeighbors++] = index + cols; }
+    if (hasBottom && hasRight) { neighbors[numNeighbors++] = index + cols + 1; }
+    return numNeighbors;
+}
+
+int TileGrid::countMineNeighbors(int index) const {
+    return cells[index] >> ADJACENT_SHIFT;
+}
+
+int TileGrid::countFlagNeighbors(int index) const {
+    int neighbors[8];
+    int numNeighbors = getNeighbors(index, neighbors);
+    int numFlagNeighbors = 0;
+    for (int i = 0; i < numNeighbors; i++) {
+        if (isFlagged(neighbors[i])) {
+            numFlagNeighbors++;
+        }
+    }
+    return numFlagNeighbors;
+}
+
+int TileGrid::countMines() const {
+    return this->numMines;
+}
+
+int TileGrid::countRevealed() const {
+    return this->numRevealed;
+}
+
+int TileGrid::countFlagged() const {
+    return this->numFlagged;
+}
+
+int TileGrid::countSafeRemaining() const {
+    return size() - numMines - numRevealedSafe;
+}
+
+const std::vector<int>& TileGrid::getDirtyTiles() const {
+    return this->dirtyTiles;
+}
+
+bool TileGrid::isAllDirty() const {
+    return this->allDirty;
+}
+
+void TileGrid::markDirty(int index) {
+    if (allDirty || (cells[index] & DIRTY) != 0) {
+        return;
+    }
+    cells[index] = static_cast<std::uint8_t>(cells[index] | DIRTY);
+    dirtyTiles.push_back(index);
+}
+
+void TileGrid::markAllDirty() {
+    clearDirty();
+    this->allDirty = true;
+}
+
+void TileGrid::clearDirty() {
+    for (int index: dirtyTiles) {
+        cells[index] = static_cast<std::uint8_t>(cells[index] & ~DIRTY);
+    }
+    dirtyTiles.clear();
+    this->allDirty = false;
+}
+
+void TileGrid::clear() {
+    std::fill(cells.begin(), cells.end(), 0);
+    dirtyTiles.clear();
+    this->allDirty = true;
+    this->numMines = 0;
+    this->numRevealed = 0;
+    this->numFlagged = 0;
+    this->numRevealedSafe = 0;
+}
@@ -0,0 +1,106 @@
+#ifndef MINESWEEPER_TILE_GRID_H
+#define MINESWEEPER_TILE_GRID_H
+
+#include <cstdint> // For std::uint8_t cells
+#include <vector> // Contiguous cell storage
+
+// Neighbor order used everywhere a tile's 3x3 neighborhood is walked
+enum pos {
+    TOP_LEFT, TOP_MID, TOP_RIGHT, MID_LEFT, MID_RIGHT, BOT_LEFT, BOT_MID, BOT_RIGHT
+};
+
+// Flat, row-major tile storage: one byte per tile, state packed as bits.
+// The high nibble caches the tile's adjacent mine count (0-8), and a dirty bit marks tiles
+// whose appearance may have changed since the renderer last caught up.
+class TileGrid {
+private:
+    enum cellBits : std::uint8_t {
+        MINE = 1 << 0, REVEALED = 1 << 1, FLAGGED = 1 << 2, DIRTY = 1 << 3,
+        ADJACENT_SHIFT = 4, ADJACENT_ONE = 1 << ADJACENT_SHIFT
+    };
+
+    int cols;
+    int rows;
+    std::vector<std::uint8_t> cells;
+    // Live totals, kept current by every setter so queries never scan the grid
+    int numMines;
+    int numRevealed;
+    int numFlagged;
+    int numRevealedSafe;
+    // Each tile appears at most once (guarded by its DIRTY bit); unused while allDirty is set
+    std::vector<int> dirtyTiles;
+    bool allDirty;
+
+    // Returns true if the bit actually changed
+    bool setBit(int index, std::uint8_t bit, bool value);
+
+public:
+    TileGrid();
+
+    TileGrid(int cols, int rows);
+
+    int getCols() const;
+
+    int getRows() const;
+
+    int size() const;
+
+    // Row-major index <-> (col, row)
+    int index(int col, int row) const;
+
+    int colOf(int index) const;
+
+    int rowOf(int index) const;
+
+    bool inBounds(int col, int row) const;
+
+    bool isMine(int index) const;
+
+    bool isRevealed(int index) const;
+
+    bool isFlagged(int index) const;
+
+    // Also updates the cached adjacency count of the 8 surrounding tiles
+    void setMine(int index, bool mine);
+
+    // Puts a mine on every tile at once, setting each adjacency count from the tile's position
+    void fillMines();
+
+    void setRevealed(int index, bool revealed);
+
+    void setFlagged(int index, bool flagged);
+
+    // Writes the on-board neighbor indices (in pos order) and returns how many there are
+    int getNeighbors(int index, int (&neighbors)[8]) const;
+
+    // Cached; a single byte read
+    int countMineNeighbors(int index) const;
+
+    int countFlagNeighbors(int index) const;
+
+    // Constant-time counters
+    int countMines() const;
+
+    int countRevealed() const;
+
+    int countFlagged() const;
+
+    // Safe tiles not yet revealed; the game is won when this reaches zero
+    int countSafeRemaining() const;
+
+    // Tiles changed since the last clearDirty(); ignore the list if isAllDirty()
+    const std::vector<int>& getDirtyTiles() const;
+
+    bool isAllDirty() const;
+
+    void markDirty(int index);
+
+    void markAllDirty();
+
+    void clearDirty();
+
+    // Blank every tile without reallocating
+    void clear();
+};
+
+#endif //MINESWEEPER_TILE_GRID_H
@@ -1,8 +1,10 @@
-#include <sstream>
+#include <cstdlib> // abs
 #include "TrayGui.h"
 
 // Constructor
-TrayGui::TrayGui(std::pair<int, int>& boardDimensions, const std::string& n) {
+TrayGui::TrayGui(std::pair<int, int>& boardDimensions, const std::string& n, const AssetRegistry& assets,
+                 const sf::Font& font)
+        : assets(assets), font(font), leaderboard("files/leaderboard.log", "files/leaderboard.txt") {
     this->boardDimensions = boardDimensions;
     startTime = std::chrono::high_resolution_clock::now();
     endTime = std::chrono::high_resolution_clock::now();
@@ -14,10 +16,23 @@ TrayGui::TrayGui(std::pair<int, int>& boardDimensions, const std::string& n) {
     gameWon = false;
     leaderboardDisplayed = false;
     name = n;
-    lbCurrentlyOpen = false;
-    buttonSprites = {};
-    hasSpace = hasSpaces();
-
+    leaderboardOpen = false;
+    pausedBeforeLeaderboard = false;
+    recordScores = true;
+    leaderboardText = "Loading...";
+    pendingLeaderboardText = ioWorker.submit([this]() {
+        leaderboard.load();
+        return leaderboard.toString(0);
+    });
+
+    // Buttons are 64x64 pixels, in a row half a tile below the board
+    float buttonTop = static_cast<float>(32 * (boardDimensions.second + 0.5));
+    buttonRects[face] = sf::FloatRect(static_cast<float>(boardDimensions.first * 16 - 32), buttonTop, 64, 64);
+    buttonRects[pause] = sf::FloatRect(static_cast<float>(boardDimensions.first * 32 - 240), buttonTop, 64, 64);
+    buttonRects[lb] = sf::FloatRect(static_cast<float>(boardDimensions.first * 32 - 176), buttonTop, 64, 64);
+    buttonRects[debug] = sf::FloatRect(static_cast<float>(boardDimensions.first * 32 - 304), buttonTop, 64, 64);
+    layoutWidgets();
+    layoutLeaderboard();
 }
 
 std::chrono::duration<double, std::milli> TrayGui::updateGameTime() {
@@ -34,6 +49,22 @@ std::chrono::duration<double, std::milli> TrayGui::updateGameTime() {
     return gameTime;
 }
 
+long long TrayGui::getElapsedSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(updateGameTime()).count();
+}
+
+bool TrayGui::isTimerRunning() const {
+    return !paused && !gameOver;
+}
+
+bool TrayGui::isGameOver() const {
+    return this->gameOver;
+}
+
+bool TrayGui::needsPolling() const {
+    return isTimerRunning() || pendingLeaderboardText.valid();
+}
+
 void TrayGui::setGameOver(bool g) {
     this->gameOver = g;
 }
@@ -42,75 +73,117 @@ void TrayGui::setGameWon(bool w) {
     this->gameWon = w;
 }
 
-void TrayGui::render(sf::RenderWindow& window, std::vector<sf::Texture>& textures,
-                     const int& numMines, const int& numFlags) {
-    enum guiTextures {
-        debug, digits, happy, lose, win, lb, pause, play
-    };
-    sf::Texture digitTexture = textures[digits];
+// Give every widget its fixed quad; only texture coordinates change after this
+void TrayGui::layoutWidgets() {
+    widgetQuads = sf::VertexArray(sf::Quads, NUM_WIDGETS * 4);
+    sf::FloatRect widgetRects[NUM_WIDGETS];
+    for (int i = 0; i < NUM_BUTTONS; i++) {
+        widgetRects[i] = buttonRects[i];
+    }
+    // Counter and timer digits are 21x32, a quarter tile below the top of the buttons
+    float digitTop = static_cast<float>(32 * (boardDimensions.second + 0.5) + 16);
+    float timerLeft = static_cast<float>(boardDimensions.first * 32);
+    widgetRects[minusDigit] = sf::FloatRect(12, digitTop, 21, 32);
+    widgetRects[minesHundreds] = sf::FloatRect(33, digitTop, 21, 32);
+    widgetRects[minesTens] = sf::FloatRect(33 + 21, digitTop, 21, 32);
+    widgetRects[minesOnes] = sf::FloatRect(33 + 21 + 21, digitTop, 21, 32);
+    widgetRects[minutesTens] = sf::FloatRect(timerLeft - 97, digitTop, 21, 32);
+    widgetRects[minutesOnes] = sf::FloatRect(timerLeft - 97 + 21, digitTop, 21, 32);
+    widgetRects[secondsTens] = sf::FloatRect(timerLeft - 54, digitTop, 21, 32);
+    widgetRects[secondsOnes] = sf::FloatRect(timerLeft - 54 + 21, digitTop, 21, 32);
+
+    for (int i = 0; i < NUM_WIDGETS; i++) {
+        const sf::FloatRect& rect = widgetRects[i];
+        sf::Vertex* quad = &widgetQuads[static_cast<size_t>(i * 4)];
+        quad[0].position = sf::Vector2f(rect.left, rect.top);
+        quad[1].position = sf::Vector2f(rect.left + rect.width, rect.top);
+        quad[2].position = sf::Vector2f(rect.left + rect.width, rect.top + rect.height);
+        quad[3].position = sf::Vector2f(rect.left, rect.top + rect.height);
+        // Nothing shown until the first update
+        widgetRegions[i] = sf::IntRect();
+        widgetVisible[i] = false;
+        for (int v = 0; v < 4; v++) {
+            quad[v].color = sf::Color::Transparent;
+        }
+    }
+}
 
-    renderMinesRemaining(window, digitTexture, numMines, numFlags);
+// Point a widget at a new atlas region; a no-op unless something actually changed
+void TrayGui::setWidget(int widget, const sf::IntRect& region, bool visible) {
+    if (region == widgetRegions[widget] && visible == widgetVisible[widget]) {
+        return;
+    }
+    widgetRegions[widget] = region;
+    widgetVisible[widget] = visible;
+    sf::FloatRect texRect(region);
+    sf::Vertex* quad = &widgetQuads[static_cast<size_t>(widget * 4)];
+    quad[0].texCoords = sf::Vector2f(texRect.left, texRect.top);
+    quad[1].texCoords = sf::Vector2f(texRect.left + texRect.width, texRect.top);
+    quad[2].texCoords = sf::Vector2f(texRect.left + texRect.width, texRect.top + texRect.height);
+    quad[3].texCoords = sf::Vector2f(texRect.left, texRect.top + texRect.height);
+    for (int v = 0; v < 4; v++) {
+        quad[v].color = visible ? sf::Color::White : sf::Color::Transparent;
+    }
+}
 
-    // Face button
-    sf::Sprite gameStateSprite;
-    if (!gameOver) {
-        gameStateSprite.setTexture(textures[happy]);
-    } else {
-        gameWon ? gameStateSprite.setTexture(textures[win]) : gameStateSprite.setTexture(textures[lose]);
+// Digit images are 21x32, side by side in the digits image; index 10 is the minus sign
+sf::IntRect TrayGui::getDigitRegion(int digit) const {
+    const sf::IntRect& digitsRegion = assets.getRegion(AssetRegistry::digits);
+    return sf::IntRect(digitsRegion.left + 21 * digit, digitsRegion.top, 21, 32);
+}
+
+void TrayGui::render(sf::RenderWindow& window, const int& numMines, const int& numFlags) {
+    // Pick up a finished leaderboard load or save
+    if (leaderboardChanged()) {
+        leaderboardContentText = initializeLeaderboardContentText();
     }
+    updateMinesRemaining(numMines, numFlags);
 
-    gameStateSprite.setPosition(static_cast<float>(boardDimensions.first * 16 - 32),
-                                static_cast<float>(32 * (boardDimensions.second + 0.5)));
-    buttonSprites.emplace_back(gameStateSprite);
-    window.draw(gameStateSprite);
+    // Face button
+    int faceAsset = AssetRegistry::happy;
+    if (gameOver) {
+        faceAsset = gameWon ? AssetRegistry::win : AssetRegistry::lose;
+    }
+    setWidget(face, assets.getRegion(faceAsset), true);
 
     // Pause button, clickable
-    sf::Sprite pauseButtonSprite;
-    paused ? pauseButtonSprite.setTexture(textures[play]) : pauseButtonSprite.setTexture(textures[pause]);
-    pauseButtonSprite.setPosition(static_cast<float>(boardDimensions.first * 32) - 240,
-                                  static_cast<float>(32 * (boardDimensions.second + 0.5)));
-    buttonSprites.emplace_back(pauseButtonSprite);
-    window.draw(pauseButtonSprite);
-
-    // Leaderboard button, clickable
-    sf::Sprite leaderboardSprite(textures[lb]);
-    leaderboardSprite.setPosition(static_cast<float>(boardDimensions.first * 32 - 176),
-                                  static_cast<float>(32 * (boardDimensions.second + 0.5)));
-    buttonSprites.emplace_back(leaderboardSprite);
-    window.draw(leaderboardSprite);
-
-    // Debug button
-    sf::Sprite debugSprite(textures[debug]);
-    debugSprite.setPosition(static_cast<float>(boardDimensions.first * 32 - 304), // 25 x 16 board
-                            static_cast<float>(32 * (boardDimensions.second + 0.5)));
-    buttonSprites.emplace_back(debugSprite);
-    window.draw(debugSprite);
+    setWidget(pause, assets.getRegion(paused ? AssetRegistry::play : AssetRegistry::pause), true);
+
+    // Leaderboard and debug buttons never change
+    setWidget(lb, assets.getRegion(AssetRegistry::lb), true);
+    setWidget(debug, assets.getRegion(AssetRegistry::debug), true);
 
     // Timer
-    renderTimer(window, digitTexture);
+    updateTimer();
+
+    // The whole tray in one draw call
+    window.draw(widgetQuads, sf::RenderStates(&assets.getTexture()));
 
     // Render leaderboard if game was won
     if (gameWon && !leaderboardDisplayed) {
-        std::chrono::duration<double, std::milli> elapsedGameTimeSeconds = updateGameTime();
-        long long elapsedMinutes = std::chrono::duration_cast<std::chrono::minutes>(elapsedGameTimeSeconds).count();
-        long long elapsedSeconds = std::chrono::duration_cast<std::chrono::seconds>(elapsedGameTimeSeconds).count();
-        if (elapsedMinutes >= 99) {
-            elapsedMinutes = 99;
+        std::chrono::duration<double, std::milli> elapsedGameTime = updateGameTime();
+        int timeMs = static_cast<int>(elapsedGameTime.count());
+        std::string playerName = name;
+        // Saved in the background; the result comes back marked with this game's place
+        if (recordScores) {
+            pendingLeaderboardText = ioWorker.submit([this, timeMs, playerName]() {
+                return leaderboard.toString(leaderboard.addScore(timeMs, playerName));
+            });
         }
-        // Convert to time format
-        std::stringstream formattedTime;
-        formattedTime << std::setfill('0') << std::setw(2) << elapsedMinutes << ":" << std::setw(2)
-                      << elapsedSeconds % 60;
-        std::pair<std::string, std::string> entry = {formattedTime.str(), name};
-        writeScore(entry);
-        window.display();
-        displayLeaderboard();
+        leaderboardContentText = initializeLeaderboardContentText();
+        pausedBeforeLeaderboard = paused;
+        leaderboardOpen = true;
         leaderboardDisplayed = true;
     }
+
+    if (leaderboardOpen) {
+        window.draw(leaderboardBackground);
+        window.draw(leaderboardHeaderText);
+        window.draw(leaderboardContentText);
+    }
 }
 
-void TrayGui::renderMinesRemaining(sf::RenderWindow& window, const sf::Texture& texture,
-                                   const int& mines, const int& flags) const {
+void TrayGui::updateMinesRemaining(const int& mines, const int& flags) {
     int minesRemaining = mines - flags;
     bool negative;
     if (minesRemaining < 0) {
@@ -122,35 +195,14 @@ void TrayGui::renderMinesRemaining(sf::RenderWindow& window, const sf::Texture&
     int hundredsPlace = abs(minesRemaining / 100);
     int tensPlace = abs(minesRemaining % 100 / 10);
     int onesPlace = abs(minesRemaining % 100 % 10);
-    sf::Sprite hundredsPlaceSprite(texture);
-    sf::Sprite tensPlaceSprite(texture);
-    sf::Sprite onesPlaceSprite(texture);
-    sf::Sprite negativeSprite(texture);
-
-    hundredsPlaceSprite.setTextureRect(sf::IntRect(21 * hundredsPlace, 0, 21, 32));
-    tensPlaceSprite.setTextureRect(sf::IntRect(21 * tensPlace, 0, 21, 32));
-    onesPlaceSprite.setTextureRect(sf::IntRect(21 * onesPlace, 0, 21, 32));
-    negativeSprite.setTextureRect(sf::IntRect((21 * 10), 0, 21, 32));
-
-    hundredsPlaceSprite.setPosition(static_cast<float>(33),
-                                    static_cast<float>(32 * (boardDimensions.second + 0.5) + 16));
-    tensPlaceSprite.setPosition(static_cast<float>(33 + 21),
-                                static_cast<float>(32 * (boardDimensions.second + 0.5) + 16));
-    onesPlaceSprite.setPosition(static_cast<float>(33 + 21 + 21),
-                                static_cast<float>(32 * (boardDimensions.second + 0.5) + 16));
-    negativeSprite.setPosition(static_cast<float>(12),
-                               static_cast<float>(32 * (boardDimensions.second + 0.5) + 16));
-    if (negative) {
-        window.draw(negativeSprite);
-    }
-    window.draw(hundredsPlaceSprite);
-    window.draw(tensPlaceSprite);
-    window.draw(onesPlaceSprite);
+    setWidget(minusDigit, getDigitRegion(10), negative);
+    setWidget(minesHundreds, getDigitRegion(hundredsPlace), true);
+    setWidget(minesTens, getDigitRegion(tensPlace), true);
+    setWidget(minesOnes, getDigitRegion(onesPlace), true);
 }
 
-// Render the timer
-void TrayGui::renderTimer(sf::RenderWindow& window,
-                          const sf::Texture& texture) {
+// Update the timer digits
+void TrayGui::updateTimer() {
     // Get minutes and seconds elapsed
     auto elapsedGameTimeSeconds = updateGameTime();
     long long elapsedMinutes = std::chrono::duration_cast<std::chrono::minutes>(elapsedGameTimeSeconds).count();
@@ -160,308 +212,164 @@ void TrayGui::renderTimer(sf::RenderWindow& window,
     }
 
     // Int divide by ten to get ten's digit and mod by ten to get one's digit
-    int topMinutesDigit = static_cast<int>(elapsedMinutes) / 10;
-    int bottomMinutesDigit = static_cast<int>(elapsedMinutes) % 10;
-    int topSecondsDigit = static_cast<int>(elapsedSeconds) % 60 / 10;
-    int bottomSecondsDigit = static_cast<int>(elapsedSeconds) % 60 % 10;
-
-    // Set textures
-    sf::Sprite topMinutesSprite(texture);
-    sf::Sprite bottomMinutesSprite(texture);
-    sf::Sprite topSecondsSprite(texture);
-    sf::Sprite bottomSecondsSprite(texture);
-    // Each digit offset by 21 pixels in width
-    topMinutesSprite.setTextureRect(sf::IntRect(21 * topMinutesDigit, 0, 21, 32));
-    bottomMinutesSprite.setTextureRect(sf::IntRect(21 * bottomMinutesDigit, 0, 21, 32));
-    topSecondsSprite.setTextureRect(sf::IntRect(21 * topSecondsDigit, 0, 21, 32));
-    bottomSecondsSprite.setTextureRect(sf::IntRect(21 * bottomSecondsDigit, 0, 21, 32));
-
-    topMinutesSprite.setPosition(static_cast<float>((boardDimensions.first * 32)) - 97,
-                                 static_cast<float>((32 * (boardDimensions.second + 0.5))) + 16);
-    bottomMinutesSprite.setPosition(static_cast<float>((boardDimensions.first * 32)) - 97 + 21,
-                                    static_cast<float>((32 * (boardDimensions.second + 0.5))) + 16);
-    topSecondsSprite.setPosition(static_cast<float>((boardDimensions.first * 32)) - 54,
-                                 static_cast<float>((32 * (boardDimensions.second + 0.5))) + 16);
-    bottomSecondsSprite.setPosition(static_cast<float>((boardDimensions.first * 32)) - 54 + 21,
-                                    static_cast<float>((32 * (boardDimensions.second + 0.5))) + 16);
-
-
-    window.draw(topMinutesSprite);
-    window.draw(bottomMinutesSprite);
-    window.draw(topSecondsSprite);
-    window.draw(bottomSecondsSprite);
+    setWidget(minutesTens, getDigitRegion(static_cast<int>(elapsedMinutes) / 10), true);
+    setWidget(minutesOnes, getDigitRegion(static_cast<int>(elapsedMinutes) % 10), true);
+    setWidget(secondsTens, getDigitRegion(static_cast<int>(elapsedSeconds) % 60 / 10), true);
+    setWidget(secondsOnes, getDigitRegion(static_cast<int>(elapsedSeconds) % 60 % 10), true);
 }
 
-bool TrayGui::click(sf::RenderWindow& window, const sf::Vector2i& mousePosition,
-                    const std::vector<sf::Texture>& tileTextures, Board& board) {
-    enum buttonSpritesIndices {
-        face, pause, lb, debug
-    };
-    enum tileTextureIndices {
-        flag, mine, num1, num2, num3, num4, num5, num6, num7, num8, hidden, revealed
-    };
-
-    lbCurrentlyOpen = false;
-    // Figure out which button was clicked
-    sf::Vector2f translatedPosition = window.mapPixelToCoords(mousePosition);
-    for (size_t i = 0; i < buttonSprites.size(); i++) {
-        if (buttonSprites[i].getGlobalBounds().contains(translatedPosition)) {
-            switch (i) {
-                case face:
-                    // Reset time and the board
-                    board.reset();
-                    this->gameOver = false;
-                    this->gameWon = false;
-                    this->leaderboardDisplayed = false;
-                    startTime = std::chrono::high_resolution_clock::now();
-                    endTime = std::chrono::high_resolution_clock::now();
-                    pausedStartTime = std::chrono::high_resolution_clock::now();
-                    pausedEndTime = std::chrono::high_resolution_clock::now();
-                    totalPausedTime = pausedStartTime - pausedEndTime;
-                    break;
-                case pause:
-                    if (gameOver) {
-                        break;
-                    }
-                    // Unpause the game
-                    if (board.paused()) {
-                        this->paused = false;
-                        board.setPaused(paused);
-                        pausedEndTime = std::chrono::high_resolution_clock::now();
-                        break;
-                    }
-                    // Pause the game
-                    this->paused = true;
-                    board.setPaused(paused);
-                    pausedStartTime = std::chrono::high_resolution_clock::now();
-                    break;
-                case lb:
-                    // Paused before opening the leaderboard?
-                    bool wasPaused;
-                    wasPaused = paused;
-                    // Pause the game
-                    if (!paused) {
-                        this->paused = true;
-                        board.setPaused(true);
-                        pausedStartTime = std::chrono::high_resolution_clock::now();
-                        board.render(window, tileTextures);
-                        window.display();
-                    }
-                    // Open leaderboard window
-                    displayLeaderboard();
-                    lbCurrentlyOpen = true;
-                    // Once closed, check previous pause state and apply it
-                    paused = wasPaused;
-                    board.setPaused(wasPaused);
-                    if (!paused) {
-                        board.render(window, tileTextures);
-                    }
-                    pausedEndTime = std::chrono::high_resolution_clock::now();
-                    window.display();
-                    break;
-                case debug:
-                    if (gameOver) {
-                        break;
-                    }
-                    // Toggle debug mode
-                    board.setDebug(!board.isDebugMode());
-                    break;
-
-                default:
-                    break;
-            }
-            // Stop after first button click
-            return lbCurrentlyOpen;
+int TrayGui::findButtonClicked(const sf::Vector2f& position) const {
+    for (int i = 0; i < NUM_BUTTONS; i++) {
+        if (buttonRects[i].contains(position)) {
+            return i;
         }
     }
-    return lbCurrentlyOpen;
+    return -1;
 }
 
-void TrayGui::displayLeaderboard() {
-    sf::RenderWindow lbWindow(sf::VideoMode(boardDimensions.first * 16,
-                                            (boardDimensions.second * 16) + 50), "Minesweeper", sf::Style::Close);
-
-    sf::Font font;
-    if (!font.loadFromFile("files/font.ttf")) {
-        throw file_read_exception("Failed to load font!");
-    }
-    sf::Text leaderboardText = initializeLeaderboardHeaderText(lbWindow, font);
-    sf::Text leaderboardContentText = initializeLeaderboardContentText(lbWindow, font);
-
-    while (lbWindow.isOpen()) {
-        sf::Event event{};
-        while (lbWindow.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                lbWindow.close();
-                return;
-            }
-            // Keep leaderboard window on top
-            if (event.type == sf::Event::LostFocus) {
-                lbWindow.requestFocus();
-            }
-        }
-        lbWindow.clear(sf::Color::Blue);
-        lbWindow.draw(leaderboardText);
-        lbWindow.draw(leaderboardContentText);
-        lbWindow.display();
-        // Sleep to avoid hogging system resources
-        sf::sleep(sf::milliseconds(25));
-
-    }
+void TrayGui::resetGame(Board& board) {
+    // Reset time and the board
+    board.reset();
+    this->gameOver = false;
+    this->gameWon = false;
+    this->leaderboardDisplayed = false;
+    // Drop the previous game's '*' marker
+    pendingLeaderboardText = ioWorker.submit([this]() {
+        return leaderboard.toString(0);
+    });
+    startTime = std::chrono::high_resolution_clock::now();
+    endTime = std::chrono::high_resolution_clock::now();
+    pausedStartTime = std::chrono::high_resolution_clock::now();
+    pausedEndTime = std::chrono::high_resolution_clock::now();
+    totalPausedTime = pausedStartTime - pausedEndTime;
 }
 
-void TrayGui::writeScore(std::pair<std::string, std::string>& newEntry) const {
-    std::fstream leaderboardFile("files/leaderboard.txt", std::ios::in);
-    if (!leaderboardFile.good()) {
-        throw file_read_exception("Failed to open files/leaderboard.txt!");
-    }
-    std::vector<std::pair<std::string, std::string>> lbEntries = {newEntry};
-    std::string contentString;
-    while (!leaderboardFile.eof()) {
-        std::string time;
-        std::string leaderboardName;
-        std::getline(leaderboardFile, time, ',');
-        // Skip the space
-        if (hasSpace) {
-            std::getline(leaderboardFile, leaderboardName, ' ');
-        }
-        std::getline(leaderboardFile, leaderboardName, '\n');
-        std::pair<std::string, std::string> lbEntry = {time, leaderboardName};
-        lbEntries.push_back(lbEntry);
+void TrayGui::setPaused(bool p, Board& board) {
+    if (paused == p) {
+        board.setPaused(p);
+        return;
     }
-    std::sort(lbEntries.begin(), lbEntries.end());
-    lbEntries.pop_back();
-    // Done reading, time to write
-    leaderboardFile.close();
-    leaderboardFile.open("files/leaderboard.txt", std::ios::out);
-    for (const auto& entry: lbEntries) {
-        if (hasSpace) {
-            leaderboardFile << entry.first << ", " << entry.second;
-        } else {
-            leaderboardFile << entry.first << "," << entry.second;
-
-        }
-        if (entry != lbEntries.back()) {
-            leaderboardFile << std::endl;
-        }
+    this->paused = p;
+    board.setPaused(paused);
+    if (paused) {
+        pausedStartTime = std::chrono::high_resolution_clock::now();
+    } else {
+        pausedEndTime = std::chrono::high_resolution_clock::now();
     }
 }
 
-sf::Text TrayGui::initializeLeaderboardHeaderText(const sf::RenderWindow& window, const sf::Font& font) {
-    sf::Text leaderboardText;
-    leaderboardText.setFont(font);
-    leaderboardText.setString("LEADERBOARD");
-    leaderboardText.setStyle(sf::Text::Underlined | sf::Text::Bold);
-    leaderboardText.setFillColor(sf::Color::White);
-    leaderboardText.setCharacterSize(20);
-
-    sf::FloatRect lbTextRect = leaderboardText.getLocalBounds();
-    leaderboardText.setOrigin(lbTextRect.left + lbTextRect.width / 2.0f,
-                              lbTextRect.top + lbTextRect.height / 2.0f);
-    leaderboardText.setPosition(static_cast<float>(window.getSize().x) / 2.0f,
-                                static_cast<float>(window.getSize().y) / 2.0f - 120);
-    return leaderboardText;
+void TrayGui::setRecordScores(bool record) {
+    this->recordScores = record;
 }
 
-sf::Text TrayGui::initializeLeaderboardContentText(const sf::RenderWindow& window, const sf::Font& font) {
-    std::string contentString;
-    std::chrono::duration<double, std::milli> elapsedGameTimeSeconds = updateGameTime();
-    long long elapsedMinutes = std::chrono::duration_cast<std::chrono::minutes>(elapsedGameTimeSeconds).count();
-    long long elapsedSeconds = std::chrono::duration_cast<std::chrono::seconds>(elapsedGameTimeSeconds).count();
-    if (elapsedMinutes >= 99) {
-        elapsedMinutes = 99;
+void TrayGui::click(sf::RenderWindow& window, const sf::Vector2i& mousePosition, Board& board) {
+    // Figure out which button was clicked
+    int button = findButtonClicked(window.mapPixelToCoords(mousePosition));
+    switch (button) {
+        case face:
+            resetGame(board);
+            break;
+        case pause:
+            if (gameOver) {
+                break;
+            }
+            setPaused(!board.paused(), board);
+            break;
+        case lb:
+            openLeaderboard(board);
+            break;
+        case debug:
+            if (gameOver) {
+                break;
+            }
+            // Toggle debug mode
+            board.setDebug(!board.isDebugMode());
+            break;
+
+        default:
+            break;
     }
-    std::stringstream formattedTime;
-    formattedTime << std::setfill('0') << std::setw(2) << elapsedMinutes << ":" << std::setw(2) << elapsedSeconds % 60;
-    gameOver && gameWon ? contentString = getLeaderboardString(name, formattedTime.str())
-                        : contentString = getLeaderboardString();
-    sf::Text leaderboardContentText;
-    leaderboardContentText.setFont(font);
-    leaderboardContentText.setString(contentString);
-    leaderboardContentText.setStyle(sf::Text::Bold);
-    leaderboardContentText.setFillColor(sf::Color::White);
-    leaderboardContentText.setCharacterSize(18);
-
-    sf::FloatRect welcomeTextRect = leaderboardContentText.getLocalBounds();
-    leaderboardContentText.setOrigin(welcomeTextRect.left + welcomeTextRect.width / 2.0f,
-                                     welcomeTextRect.top + welcomeTextRect.height / 2.0f);
-    leaderboardContentText.setPosition(static_cast<float>(window.getSize().x) / 2.0f,
-                                       static_cast<float>(window.getSize().y) / 2.0f + 20);
-    return leaderboardContentText;
 }
 
-std::string TrayGui::getLeaderboardString(const std::string& lbName, const std::string& lbTime) const {
-    std::ifstream leaderboardFile("files/leaderboard.txt");
-    if (!leaderboardFile.good()) {
-        throw file_read_exception("Failed to open files/leaderboard.txt!");
+void TrayGui::openLeaderboard(Board& board) {
+    // Paused before opening the leaderboard?
+    pausedBeforeLeaderboard = paused;
+    // Pause the game
+    if (!paused) {
+        this->paused = true;
+        board.setPaused(true);
+        pausedStartTime = std::chrono::high_resolution_clock::now();
     }
-    std::string contentString;
-    int iteration = 1;
-    while (!leaderboardFile.eof()) {
-        std::string time;
-        std::string leaderboardName;
-        std::getline(leaderboardFile, time, ',');
-        if (hasSpace) {
-            std::getline(leaderboardFile, leaderboardName, ' ');
-        }
-        std::getline(leaderboardFile, leaderboardName, '\n');
+    leaderboardContentText = initializeLeaderboardContentText();
+    leaderboardOpen = true;
+}
 
-        // Build content string
-        contentString.append(std::to_string(iteration)).append(std::string(".")).append
-                (std::string("\t")).append(time).append(std::string("\t")).append(leaderboardName);
+void TrayGui::closeLeaderboard(Board& board) {
+    leaderboardOpen = false;
+    // Once closed, check previous pause state and apply it
+    paused = pausedBeforeLeaderboard;
+    board.setPaused(pausedBeforeLeaderboard);
+    pausedEndTime = std::chrono::high_resolution_clock::now();
+}
 
-        if (lbName == leaderboardName && lbTime == time) {
-            contentString += "*";
-        }
-        contentString.append("\n\n");
-        iteration++;
+bool TrayGui::isLeaderboardOpen() const {
+    return this->leaderboardOpen;
+}
 
-    }
-    return contentString;
+// The overlay is the size the old leaderboard window was, centered over the board
+void TrayGui::layoutLeaderboard() {
+    float boardWidth = static_cast<float>(boardDimensions.first * 32);
+    float boardHeight = static_cast<float>(boardDimensions.second * 32);
+    float width = static_cast<float>(boardDimensions.first * 16);
+    float height = static_cast<float>(boardDimensions.second * 16 + 50);
+    leaderboardArea = sf::FloatRect((boardWidth - width) / 2.0f, (boardHeight - height) / 2.0f, width, height);
+    leaderboardBackground.setSize(sf::Vector2f(width, height));
+    leaderboardBackground.setPosition(leaderboardArea.left, leaderboardArea.top);
+    leaderboardBackground.setFillColor(sf::Color::Blue);
+    leaderboardHeaderText = initializeLeaderboardHeaderText();
 }
 
-std::string TrayGui::getLeaderboardString() const {
-    std::ifstream leaderboardFile("files/leaderboard.txt");
-    if (!leaderboardFile.good()) {
-        throw file_read_exception("Failed to open files/leaderboard.txt!");
-    }
-    std::string contentString;
-    std::stringstream buffer;
-    int iteration = 1;
-    // Jump to beginning of file and clear the eof bit
-    leaderboardFile.clear();
-    leaderboardFile.seekg(0, std::ios::beg);
-    while (!leaderboardFile.eof()) {
-        std::string time;
-        std::string leaderboardName;
-        std::getline(leaderboardFile, time, ',');
-        // Skip the space if the original file has spaces
-        if (hasSpace) {
-            std::getline(leaderboardFile, leaderboardName, ' ');
-        }
-        std::getline(leaderboardFile, leaderboardName, '\n');
+sf::Text TrayGui::initializeLeaderboardHeaderText() const {
+    sf::Text headerText;
+    headerText.setFont(font);
+    headerText.setString("LEADERBOARD");
+    headerText.setStyle(sf::Text::Underlined | sf::Text::Bold);
+    headerText.setFillColor(sf::Color::White);
+    headerText.setCharacterSize(20);
+
+    sf::FloatRect headerTextRect = headerText.getLocalBounds();
+    headerText.setOrigin(headerTextRect.left + headerTextRect.width / 2.0f,
+                         headerTextRect.top + headerTextRect.height / 2.0f);
+    headerText.setPosition(leaderboardArea.left + leaderboardArea.width / 2.0f,
+                           leaderboardArea.top + leaderboardArea.height / 2.0f - 120);
+    return headerText;
+}
 
-        // Build content string
-        contentString += std::to_string(iteration) += std::string(".") += std::string("\t") +=
-        time += std::string("\t") += leaderboardName += "\n\n";
-        iteration++;
-    }
-    return contentString;
+sf::Text TrayGui::initializeLeaderboardContentText() {
+    std::string contentString = getLeaderboardString();
+    sf::Text contentText;
+    contentText.setFont(font);
+    contentText.setString(contentString);
+    contentText.setStyle(sf::Text::Bold);
+    contentText.setFillColor(sf::Color::White);
+    contentText.setCharacterSize(18);
+
+    sf::FloatRect contentTextRect = contentText.getLocalBounds();
+    contentText.setOrigin(contentTextRect.left + contentTextRect.width / 2.0f,
+                          contentTextRect.top + contentTextRect.height / 2.0f);
+    contentText.setPosition(leaderboardArea.left + leaderboardArea.width / 2.0f,
+                            leaderboardArea.top + leaderboardArea.height / 2.0f + 20);
+    return contentText;
 }
 
-bool TrayGui::hasSpaces() {
-    std::ifstream leaderboardFile("files/leaderboard.txt");
-    if (!leaderboardFile.good()) {
-        throw file_read_exception("Failed to open files/leaderboard.txt!");
+std::string TrayGui::getLeaderboardString() {
+    if (leaderboardChanged()) {
+        // Rethrows anything the worker threw, e.g. file_read_exception
+        leaderboardText = pendingLeaderboardText.get();
     }
-    char c;
-    while (leaderboardFile >> std::noskipws >> c) {
-        if (c == ' ') {
-            leaderboardFile.close();
-            return true;
-        }
-    }
-    leaderboardFile.close();
-    return false;
+    return leaderboardText;
 }
 
+bool TrayGui::leaderboardChanged() const {
+    return IoWorker::isReady(pendingLeaderboardText);
+}
@@ -2,14 +2,16 @@
 #define MINESWEEPER_TRAY_GUI_H
 
 #include <chrono>
-#include <fstream>
-#include <iomanip>
 #include <SFML/Graphics.hpp>
+#include "AssetRegistry.h"
 #include "Board.h"
+#include "IoWorker.h"
+#include "Leaderboard.h"
 #include "file_read_exception.h"
 
 class TrayGui {
 private:
+    // Tiles across and down the window's board area, which is smaller than a board too big to fit
     std::pair<int, int> boardDimensions;
     std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
     std::chrono::time_point<std::chrono::high_resolution_clock> endTime;
@@ -20,44 +22,104 @@ private:
     bool gameOver;
     bool gameWon;
     bool leaderboardDisplayed;
-    bool hasSpace;
-    bool lbCurrentlyOpen;
     std::string name;
-    std::vector<sf::Sprite> buttonSprites;
+    const AssetRegistry& assets;
+    // Loaded once in main(); reused so its glyph cache stays warm
+    const sf::Font& font;
+    // Leaderboard overlay, drawn over the board inside the game window
+    bool leaderboardOpen;
+    bool pausedBeforeLeaderboard;
+    // Off while playing back a replay, so a replayed win is not saved again
+    bool recordScores;
+    sf::FloatRect leaderboardArea;
+    sf::RectangleShape leaderboardBackground;
+    sf::Text leaderboardHeaderText;
+    sf::Text leaderboardContentText;
+    // Only ever touched from tasks on ioWorker
+    Leaderboard leaderboard;
+    // Declared after the leaderboard so it is destroyed (and flushed) first
+    IoWorker ioWorker;
+    // Formatted leaderboard most recently handed back by the worker, and the next one in flight
+    std::string leaderboardText;
+    std::future<std::string> pendingLeaderboardText;
+    // Fixed button layout, in click priority order
+    enum buttons {
+        face, pause, lb, debug, NUM_BUTTONS
+    };
+    sf::FloatRect buttonRects[NUM_BUTTONS];
+    // Retained widgets: the buttons, then the mine counter and timer digits.
+    // Each is one quad laid out once; state changes only rewrite its texture coordinates.
+    enum widgets {
+        minusDigit = NUM_BUTTONS, minesHundreds, minesTens, minesOnes,
+        minutesTens, minutesOnes, secondsTens, secondsOnes, NUM_WIDGETS
+    };
+    sf::VertexArray widgetQuads;
+    sf::IntRect widgetRegions[NUM_WIDGETS];
+    bool widgetVisible[NUM_WIDGETS];
+
+    // Index of the button under a point, or -1
+    int findButtonClicked(const sf::Vector2f& position) const;
+
+    void layoutWidgets();
+
+    void setWidget(int widget, const sf::IntRect& region, bool visible);
+
+    sf::IntRect getDigitRegion(int digit) const;
+
+    void updateTimer();
+
+    void updateMinesRemaining(const int& mines, const int& flags);
+
+    void layoutLeaderboard();
+
+    sf::Text initializeLeaderboardHeaderText() const;
+
+    sf::Text initializeLeaderboardContentText();
+
+    void openLeaderboard(Board& board);
 
 public:
-    explicit TrayGui(std::pair<int, int>& boardDimensions, const std::string& n);
+    TrayGui(std::pair<int, int>& boardDimensions, const std::string& n, const AssetRegistry& assets,
+            const sf::Font& font);
 
     std::chrono::duration<double, std::milli> updateGameTime();
 
-    void setGameOver(bool g);
+    // Whole seconds shown on the timer
+    long long getElapsedSeconds();
 
-    void setGameWon(bool w);
+    // The timer only advances while the game is neither paused nor over
+    bool isTimerRunning() const;
+
+    bool isGameOver() const;
 
-    void render(sf::RenderWindow& window, std::vector<sf::Texture>& textures,
-                const int& numMines, const int& numFlags);
+    // True while something can change without input: the timer, or a leaderboard result in flight
+    bool needsPolling() const;
 
-    void renderTimer(sf::RenderWindow& window, const sf::Texture& textures);
+    void setGameOver(bool g);
+
+    void setGameWon(bool w);
 
-    void renderMinesRemaining(sf::RenderWindow& window, const sf::Texture& texture,
-                              const int& mines, const int& flags) const;
+    void render(sf::RenderWindow& window, const int& numMines, const int& numFlags);
 
-    bool click(sf::RenderWindow& window, const sf::Vector2i& mousePosition,
-               const std::vector<sf::Texture>& tileTextures, Board& board);
+    // What the face button does: a new board and a fresh timer
+    void resetGame(Board& board);
 
-    void displayLeaderboard();
+    // What the pause button does, keeping the timer and the board in step
+    void setPaused(bool p, Board& board);
 
-    void writeScore(std::pair<std::string, std::string>& newEntry) const;
+    void setRecordScores(bool record);
 
-    static sf::Text initializeLeaderboardHeaderText(const sf::RenderWindow& window, const sf::Font& font);
+    void click(sf::RenderWindow& window, const sf::Vector2i& mousePosition, Board& board);
 
-    sf::Text initializeLeaderboardContentText(const sf::RenderWindow& window, const sf::Font& font);
+    bool isLeaderboardOpen() const;
 
-    std::string getLeaderboardString(const std::string& lbName, const std::string& lbTime) const;
+    // Hide the overlay and restore the pause state from before it opened
+    void closeLeaderboard(Board& board);
 
-    std::string getLeaderboardString() const;
+    // Never blocks: picks up a finished worker result if there is one
+    std::string getLeaderboardString();
 
-    static bool hasSpaces();
+    bool leaderboardChanged() const;
 };
 
 #endif //MINESWEEPER_TRAY_GUI_H
@@ -0,0 +1,324 @@
+#include <atomic> // Allocation counter
+#include <chrono> // Timing
+#include <cstdio> // Table output
+#include <cstdlib> // std::malloc, std::free, std::atof
+#include <fstream> // JSON output
+#include <functional> // Benchmark bodies
+#include <new> // Global operator new/delete replacements
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "ProbabilityEngine.h"
+#include "Solver.h"
+
+// Every heap allocation in the process goes through here, so each benchmark can report allocations per op
+static std::atomic<long long> allocationCount(0);
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    typedef std::chrono::steady_clock benchClock;
+
+    struct Result {
+        std::string name;
+        int cols;
+        int rows;
+        int densityPercent;
+        long long iterations;
+        double nsPerOp;
+        double allocationsPerOp;
+        double tilesPerSecond;
+    };
+
+    // Keeps the optimizer from discarding work whose result is otherwise unused
+    volatile long long sink;
+
+    // Stand-in for sf::Vertex: a screen position and an atlas position
+    struct QuadVertex {
+        float x;
+        float y;
+        float u;
+        float v;
+    };
+
+    // Atlas slots in AssetRegistry order, so the choice per tile matches BoardRenderer::appendTile
+    enum benchAssets {
+        flagAsset, num1Asset, mineAsset = num1Asset + 8, hiddenAsset, revealedAsset
+    };
+
+    // Same work as BoardRenderer::appendQuad, with 32x32 atlas regions laid out in a row
+    void appendQuad(std::vector<QuadVertex>& vertices, int col, int row, int asset) {
+        float left = static_cast<float>(col) * 32;
+        float top = static_cast<float>(row) * 32;
+        float texLeft = static_cast<float>(asset) * 32;
+        vertices.push_back({left, top, texLeft, 0});
+        vertices.push_back({left + 32, top, texLeft + 32, 0});
+        vertices.push_back({left + 32, top + 32, texLeft + 32, 32});
+        vertices.push_back({left, top + 32, texLeft, 32});
+    }
+
+    // Base and overlay quads of one tile, as BoardRenderer::appendTile picks them
+    void appendTile(const Board& board, int index, std::vector<QuadVertex>& base, std::vector<QuadVertex>& overlay) {
+        const TileGrid& grid = board.getGrid();
+        int col = grid.colOf(index);
+        int row = grid.rowOf(index);
+        bool hasMine = grid.isMine(index);
+        if (grid.isRevealed(index)) {
+            if (hasMine) {
+                appendQuad(base, col, row, hiddenAsset);
+                appendQuad(overlay, col, row, board.isGameWon() ? flagAsset : mineAsset);
+                return;
+            }
+            appendQuad(base, col, row, revealedAsset);
+            int numMineNeighbors = grid.countMineNeighbors(index);
+            if (numMineNeighbors != 0) {
+                appendQuad(overlay, col, row, num1Asset + numMineNeighbors - 1);
+            }
+            return;
+        }
+        appendQuad(base, col, row, hiddenAsset);
+        if (board.isDebugMode() && hasMine) {
+            appendQuad(overlay, col, row, mineAsset);
+        }
+        if (grid.isFlagged(index)) {
+            appendQuad(overlay, col, row, flagAsset);
+        }
+    }
+
+    // One timed op: setup runs untimed before each call to body, which returns the tiles it processed
+    struct Benchmark {
+        std::string name;
+        std::function<void(Board&)> setup;
+        std::function<long long(Board&)> body;
+    };
+
+    Result run(const Benchmark& benchmark, int cols, int rows, int densityPercent, double minSeconds) {
+        int mines = static_cast<int>(static_cast<long long>(cols) * rows * densityPercent / 100);
+        // Fixed seed: every build sees the same boards
+        Board board(std::make_pair(cols, rows), mines, 1);
+        long long iterations = 0;
+        long long tiles = 0;
+        long long allocations = 0;
+        std::chrono::nanoseconds elapsed(0);
+        benchClock::time_point wallStart = benchClock::now();
+        // Always run at least once; large boards are slow enough that one iteration is a fair sample.
+        // Untimed setup counts against a wall-clock cap so a cheap op after an expensive setup still finishes.
+        while (iterations == 0 || (std::chrono::duration<double>(elapsed).count() < minSeconds &&
+                                   std::chrono::duration<double>(benchClock::now() - wallStart).count() <
+                                   minSeconds * 5)) {
+            benchmark.setup(board);
+            long long allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            benchClock::time_point start = benchClock::now();
+            tiles += benchmark.body(board);
+            elapsed += benchClock::now() - start;
+            allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+            iterations++;
+        }
+        double ns = static_cast<double>(elapsed.count());
+        Result result;
+        result.name = benchmark.name;
+        result.cols = cols;
+        result.rows = rows;
+        result.densityPercent = densityPercent;
+        result.iterations = iterations;
+        result.nsPerOp = ns / static_cast<double>(iterations);
+        result.allocationsPerOp = static_cast<double>(allocations) / static_cast<double>(iterations);
+        result.tilesPerSecond = ns > 0 ? static_cast<double>(tiles) * 1e9 / ns : 0;
+        return result;
+    }
+
+    std::vector<Benchmark> makeBenchmarks() {
+        std::vector<Benchmark> benchmarks;
+        // Fresh board: allocation plus mine placement (populateBoard)
+        benchmarks.push_back({"construct", [](Board&) {}, [](Board& board) {
+            Board fresh(std::make_pair(board.getGrid().getCols(), board.getGrid().getRows()), board.getMines(),
+                        board.getSeed());
+            fresh.generate(fresh.getGrid().getCols() / 2, fresh.getGrid().getRows() / 2);
+            sink = fresh.getFlags();
+            return static_cast<long long>(fresh.getGrid().size());
+        }});
+        // Clear and re-place mines in the existing storage
+        benchmarks.push_back({"reset", [](Board&) {}, [](Board& board) {
+            board.reset();
+            board.generate(board.getGrid().getCols() / 2, board.getGrid().getRows() / 2);
+            return static_cast<long long>(board.getGrid().size());
+        }});
+        // Flood fill from the centre of a fresh board, which is always an opening; throughput counts the tiles
+        // actually opened
+        benchmarks.push_back({"reveal", [](Board& board) {
+            board.reset();
+            board.generate(board.getGrid().getCols() / 2, board.getGrid().getRows() / 2);
+        }, [](Board& board) {
+            board.reveal(board.getGrid().getCols() / 2, board.getGrid().getRows() / 2);
+            return static_cast<long long>(board.getRevealed());
+        }});
+        // One sweep asking every tile for its adjacent mine count
+        benchmarks.push_back({"neighborCounts", [](Board&) {}, [](Board& board) {
+            long long total = 0;
+            for (int row = 0; row < board.getGrid().getRows(); row++) {
+                for (int col = 0; col < board.getGrid().getCols(); col++) {
+                    total += board.getTile(col, row).getNumMineNeighbors();
+                }
+            }
+            sink = total;
+            return static_cast<long long>(board.getGrid().size());
+        }});
+        // Capture and solve the board a player sees after the opening click
+        benchmarks.push_back({"solve", [](Board& board) {
+            board.reset();
+            board.reveal(board.getGrid().getCols() / 2, board.getGrid().getRows() / 2);
+        }, [](Board& board) {
+            static Solver solver;
+            static SolverInput input;
+            static SolverResult result;
+            static std::atomic<bool> cancelled(false);
+            input.capture(board);
+            solver.solve(input, result, cancelled);
+            sink = result.safe.count();
+            return static_cast<long long>(board.getGrid().size());
+        }});
+        // Mine probabilities for the same position, given the solver's result; runs on every core
+        benchmarks.push_back({"probabilities", [](Board& board) {
+            board.reset();
+            board.reveal(board.getGrid().getCols() / 2, board.getGrid().getRows() / 2);
+        }, [](Board& board) {
+            static Solver solver;
+            static ProbabilityEngine engine;
+            static SolverInput input;
+            static SolverResult known;
+            static ProbabilityResult result;
+            static std::atomic<bool> cancelled(false);
+            input.capture(board);
+            solver.solve(input, known, cancelled);
+            engine.estimate(input, known, result, board.getSeed(), cancelled);
+            sink = result.safestTile();
+            return static_cast<long long>(board.getGrid().size());
+        }});
+        // The renderer's per-frame work after the opening click, without SFML: walk the dirty list and build
+        // the quads of every changed tile. Throughput counts the dirty tiles.
+        benchmarks.push_back({"renderPrep", [](Board& board) {
+            board.reset();
+            board.generate(board.getGrid().getCols() / 2, board.getGrid().getRows() / 2);
+            board.clearDirty();
+            board.reveal(board.getGrid().getCols() / 2, board.getGrid().getRows() / 2);
+        }, [](Board& board) {
+            // Kept between frames like the renderer's vertex arrays, so steady state does not allocate
+            static std::vector<QuadVertex> base;
+            static std::vector<QuadVertex> overlay;
+            const TileGrid& grid = board.getGrid();
+            base.clear();
+            overlay.clear();
+            long long tiles = 0;
+            if (grid.isAllDirty()) {
+                for (int i = 0; i < grid.size(); i++) {
+                    appendTile(board, i, base, overlay);
+                }
+                tiles = grid.size();
+            } else {
+                for (int index: grid.getDirtyTiles()) {
+                    appendTile(board, index, base, overlay);
+                }
+                tiles = static_cast<long long>(grid.getDirtyTiles().size());
+            }
+            board.clearDirty();
+            sink = static_cast<long long>(base.size() + overlay.size());
+            return tiles;
+        }});
+        // A single counter query; processes no tiles
+        benchmarks.push_back({"getRevealed", [](Board&) {}, [](Board& board) {
+            sink = board.getRevealed();
+            return 0LL;
+        }});
+        return benchmarks;
+    }
+
+    void writeJson(const std::string& path, const std::vector<Result>& results) {
+        std::ofstream out(path);
+        out << "{\n  \"compiler\": \"" << __VERSION__ << "\",\n  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            out << "    {\"name\": \"" << r.name << "\", \"cols\": " << r.cols << ", \"rows\": " << r.rows
+                << ", \"densityPercent\": " << r.densityPercent << ", \"iterations\": " << r.iterations
+                << ", \"nsPerOp\": " << r.nsPerOp << ", \"allocationsPerOp\": " << r.allocationsPerOp
+                << ", \"tilesPerSecond\": " << r.tilesPerSecond << "}" << (i + 1 < results.size() ? "," : "")
+                << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+}
+
+// Usage: Minesweeper_bench [--json path] [--min-time seconds] [--max-tiles n]
+int main(int argc, char* argv[]) {
+    std::string jsonPath = "bench_results.json";
+    double minSeconds = 0.2;
+    long long maxTiles = 4000LL * 4000LL;
+    for (int i = 1; i < argc; i += 2) {
+        std::string arg = argv[i];
+        // Every option takes a value; anything else would otherwise run the full suite
+        bool known = arg == "--json" || arg == "--min-time" || arg == "--max-tiles";
+        if (!known || i + 1 >= argc) {
+            std::fprintf(stderr, "%s: %s\n", known ? "missing value for" : "unknown option", arg.c_str());
+            std::fprintf(stderr, "Usage: Minesweeper_bench [--json path] [--min-time seconds] [--max-tiles n]\n");
+            return EXIT_FAILURE;
+        }
+        if (arg == "--json") {
+            jsonPath = argv[i + 1];
+        } else if (arg == "--min-time") {
+            minSeconds = std::atof(argv[i + 1]);
+        } else {
+            maxTiles = std::atoll(argv[i + 1]);
+        }
+    }
+
+    const int sizes[][2] = {{9, 9}, {30, 16}, {100, 100}, {1000, 1000}, {4000, 4000}};
+    const int densities[] = {1, 10, 20, 50, 90};
+    std::vector<Benchmark> benchmarks = makeBenchmarks();
+    std::vector<Result> results;
+
+    std::printf("%-16s %11s %8s %12s %14s %12s %16s\n",
+                "benchmark", "size", "density", "iterations", "ns/op", "allocs/op", "tiles/s");
+    for (const Benchmark& benchmark: benchmarks) {
+        for (const int* size: sizes) {
+            if (static_cast<long long>(size[0]) * size[1] > maxTiles) {
+                continue;
+            }
+            for (int density: densities) {
+                Result r = run(benchmark, size[0], size[1], density, minSeconds);
+                std::printf("%-16s %5dx%-5d %7d%% %12lld %14.1f %12.2f %16.0f\n", r.name.c_str(), r.cols, r.rows,
+                            r.densityPercent, r.iterations, r.nsPerOp, r.allocationsPerOp, r.tilesPerSecond);
+                std::fflush(stdout);
+                results.push_back(r);
+            }
+        }
+    }
+    writeJson(jsonPath, results);
+    std::printf("Wrote %s\n", jsonPath.c_str());
+    return EXIT_SUCCESS;
+}
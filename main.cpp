@@ -1,12 +1,40 @@
 #include <SFML/Graphics.hpp>
+#include <algorithm> // std::min for window sizes
+#include <chrono> // Replay timing
+#include <cmath> // std::floor for endless mode hit-testing, std::pow for zooming
 #include <fstream> // For reading and writing .cfg files and leaderboard
 #include <string> // For writing to leaderboard & reading files
+#include <iostream> // Command-line errors
+#include <memory> // std::unique_ptr
+#include "Rng.h"
+#include "ReplayLog.h"
+#include "HintEngine.h"
 #include "Board.h"
+#include "EndlessBoard.h"
+#include "BotProtocol.h"
+#include "Simulator.h"
+#include "Strategy.h"
+#include "AssetRegistry.h"
+#include "BoardCamera.h"
+#include "BoardRenderer.h"
 #include "TrayGui.h"
 #include "file_read_exception.h"
 #include <SFML/Config.hpp>
 
-std::vector<int> readConfig();
+// Most tiles a window shows across and down; larger boards pan and zoom inside it
+const int MAX_WINDOW_COLS = 40;
+const int MAX_WINDOW_ROWS = 22;
+
+// Height of the tray below the board area
+const int TRAY_HEIGHT = 100;
+
+std::vector<int> readConfig(std::uint64_t& seed);
+
+std::pair<int, int> windowTiles(const std::pair<int, int>& dimensions);
+
+bool parseUnsigned(const std::string& text, std::uint64_t& value);
+
+std::string windowTitle(const Board& board);
 
 sf::Text initializeWelcomeText(const sf::RenderWindow& window, const sf::Font& font);
 
@@ -14,27 +42,135 @@ sf::Text initializeNameEntryText(const sf::RenderWindow& window, const sf::Font&
 
 sf::Text fillNameEntryField(const sf::RenderWindow& window, const sf::Font& font, std::string name);
 
-bool renderWelcomeWindow(sf::RenderWindow& window, std::string& name);
+bool renderWelcomeWindow(sf::RenderWindow& window, std::string& name, const sf::Font& font);
+
+void renderGameWindow(sf::RenderWindow& window, Board& board, TrayGui& gui, const AssetRegistry& assets,
+                      ReplayReader* replay);
+
+bool handleCameraEvent(const sf::Event& event, const sf::RenderWindow& window, BoardCamera& camera, bool& dragging,
+                       sf::Vector2i& dragPosition);
+
+void applyReplayEvent(const ReplayEvent& event, Board& board, TrayGui& gui);
+
+int playReplay(const std::string& path);
 
-void renderGameWindow(sf::RenderWindow& window, Board& board, TrayGui& gui);
+int verifyReplay(const std::string& path, long long seekMs);
 
-std::vector<sf::Texture> loadTextures();
+void printBoard(const Board& board);
+
+void renderEndlessWindow(sf::RenderWindow& window, EndlessBoard& board, const AssetRegistry& assets);
+
+int runSimulation(int cols, int rows, int mines, long long games, const std::string& strategyName, int threads,
+                  std::uint64_t seed);
 
 int main(int argc, char* argv[]) {
-    std::vector<int> gameParameters = readConfig();
+    std::uint64_t seed = 0;
+    bool hasSeed = false;
+    std::string replayPath;
+    bool headless = false;
+    long long seekMs = -1;
+    std::uint64_t seekValue = 0;
+    std::uint64_t simulateGames = 0;
+    std::string strategyName = "probability";
+    std::uint64_t threads = 0;
+    std::uint64_t size[3] = {0, 0, 0};
+    bool bot = false;
+    bool endless = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--seed" && hasValue && parseUnsigned(argv[i + 1], seed)) {
+            hasSeed = true;
+            i++;
+        } else if (arg == "--replay" && hasValue) {
+            replayPath = argv[++i];
+        } else if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--seek" && hasValue && parseUnsigned(argv[i + 1], seekValue)) {
+            seekMs = static_cast<long long>(seekValue);
+            i++;
+        } else if (arg == "--endless") {
+            endless = true;
+        } else if (arg == "--bot") {
+            bot = true;
+        } else if (arg == "--simulate" && hasValue && parseUnsigned(argv[i + 1], simulateGames)) {
+            i++;
+        } else if (arg == "--strategy" && hasValue) {
+            strategyName = argv[++i];
+        } else if (arg == "--threads" && hasValue && parseUnsigned(argv[i + 1], threads)) {
+            i++;
+        } else if (arg == "--size" && i + 3 < argc && parseUnsigned(argv[i + 1], size[0]) &&
+                   parseUnsigned(argv[i + 2], size[1]) && parseUnsigned(argv[i + 3], size[2])) {
+            i += 3;
+        } else {
+            std::cerr << "Usage: Minesweeper [--seed N] [--endless]" << std::endl
+                      << "       Minesweeper --replay FILE [--headless [--seek MS]]" << std::endl
+                      << "       Minesweeper --simulate GAMES [--strategy random|solver|probability]"
+                      << " [--threads N] [--size COLS ROWS MINES] [--seed N]" << std::endl
+                      << "       Minesweeper --bot   (text protocol on stdin/stdout; see BotProtocol.h)" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    // The client sends NEW with every board parameter, so the config is not needed
+    if (bot) {
+        std::ios::sync_with_stdio(false);
+        std::cin.tie(nullptr);
+        BotProtocol().run(std::cin, std::cout);
+        return EXIT_SUCCESS;
+    }
+    // Replays carry their own board parameters
+    if (!replayPath.empty()) {
+        return headless ? verifyReplay(replayPath, seekMs) : playReplay(replayPath);
+    }
+
+    // Seed precedence: --seed, then the config's optional 4th line, then a random one
+    std::uint64_t configSeed = Rng::randomSeed();
+    std::vector<int> gameParameters = readConfig(configSeed);
+    if (!hasSeed) {
+        seed = configSeed;
+    }
     int colCount = gameParameters[0];
     int rowCount = gameParameters[1];
     int mineCount = gameParameters[2];
 
+    // Headless batch play; --size overrides the configured board
+    if (simulateGames > 0) {
+        if (size[0] > 0) {
+            colCount = static_cast<int>(size[0]);
+            rowCount = static_cast<int>(size[1]);
+            mineCount = static_cast<int>(size[2]);
+        }
+        return runSimulation(colCount, rowCount, mineCount, static_cast<long long>(simulateGames), strategyName,
+                             static_cast<int>(threads), seed);
+    }
+
     std::pair<int, int> dimensions = {colCount, rowCount};
+    // The tray is laid out across the window, not the board
+    std::pair<int, int> visible = windowTiles(dimensions);
+
+    // No edges and no tray: the configured size is only the window, and its mine density carries over
+    if (endless) {
+        sf::RenderWindow endlessWindow(sf::VideoMode(visible.first * 32, visible.second * 32), "Minesweeper",
+                                       sf::Style::Close);
+        AssetRegistry assets;
+        EndlessBoard board(static_cast<double>(mineCount) / (static_cast<double>(colCount) * rowCount), seed);
+        renderEndlessWindow(endlessWindow, board, assets);
+        return EXIT_SUCCESS;
+    }
 
     // welcomeWindow object
     sf::RenderWindow welcomeWindow(sf::VideoMode(
-            colCount * 32, rowCount * 32 + 100), "Minesweeper", sf::Style::Close);
+            visible.first * 32, visible.second * 32 + TRAY_HEIGHT), "Minesweeper", sf::Style::Close);
+
+    // Loaded once and shared by the welcome window and the leaderboard overlay
+    sf::Font font;
+    if (!font.loadFromFile("files/font.ttf")) {
+        throw file_read_exception("Failed to load font!");
+    }
 
     std::string name;
     // Render the welcome menu
-    if (renderWelcomeWindow(welcomeWindow, name)) {
+    if (renderWelcomeWindow(welcomeWindow, name, font)) {
         return EXIT_SUCCESS;
     }
 
@@ -46,134 +182,427 @@ int main(int argc, char* argv[]) {
     // After closing the welcome menu create the game window
     welcomeWindow.close();
     sf::RenderWindow gameWindow(sf::VideoMode(
-            colCount * 32, rowCount * 32 + 100), "Minesweeper", sf::Style::Close);
+            visible.first * 32, visible.second * 32 + TRAY_HEIGHT), "Minesweeper", sf::Style::Close);
+
+    // Every image, loaded once into one atlas shared by the board and the tray
+    AssetRegistry assets;
 
     // Create a board and a TrayGui
-    Board board = Board(dimensions, mineCount);
-    TrayGui gui = TrayGui(dimensions, name);
+    ReplayWriter recorder;
+    Board board = Board(dimensions, mineCount, seed);
+    TrayGui gui(visible, name, assets, font);
+
+    // Every session is recorded; play it back with --replay files/last_game.msr
+    recorder.begin("files/last_game.msr", board);
+    board.setRecorder(&recorder);
 
-    renderGameWindow(gameWindow, board, gui);
+    renderGameWindow(gameWindow, board, gui, assets, nullptr);
     // Load the board
     return EXIT_SUCCESS;
 }
 
-sf::Texture loadTexture(const std::string& fileName) {
-    sf::Texture texture;
-    if (!texture.loadFromFile(fileName)) {
-        throw file_read_exception("Textures were missing from directory files/images!");
+// Plays a recorded session back in the game window at the speed it was played
+int playReplay(const std::string& path) {
+    ReplayReader reader(path);
+    std::pair<int, int> dimensions = {reader.getCols(), reader.getRows()};
+    std::pair<int, int> visible = windowTiles(dimensions);
+    sf::RenderWindow window(sf::VideoMode(
+            visible.first * 32, visible.second * 32 + TRAY_HEIGHT), "Minesweeper", sf::Style::Close);
+    sf::Font font;
+    if (!font.loadFromFile("files/font.ttf")) {
+        throw file_read_exception("Failed to load font!");
     }
-    return texture;
+    AssetRegistry assets;
+    Board board = Board(dimensions, reader.getMines(), reader.getSeed());
+    TrayGui gui(visible, "Replay", assets, font);
+    gui.setRecordScores(false);
+    renderGameWindow(window, board, gui, assets, &reader);
+    return EXIT_SUCCESS;
 }
 
-// Load textures for sprites
-std::vector<sf::Texture> loadTextures() {
-    std::vector<sf::Texture> textures;
-    textures.push_back(loadTexture("files/images/flag.png"));
-    textures.push_back(loadTexture("files/images/number_1.png"));
-    textures.push_back(loadTexture("files/images/number_2.png"));
-    textures.push_back(loadTexture("files/images/number_3.png"));
-    textures.push_back(loadTexture("files/images/number_4.png"));
-    textures.push_back(loadTexture("files/images/number_5.png"));
-    textures.push_back(loadTexture("files/images/number_6.png"));
-    textures.push_back(loadTexture("files/images/number_7.png"));
-    textures.push_back(loadTexture("files/images/number_8.png"));
-    textures.push_back(loadTexture("files/images/debug.png"));
-    textures.push_back(loadTexture("files/images/digits.png"));
-    textures.push_back(loadTexture("files/images/face_happy.png"));
-    textures.push_back(loadTexture("files/images/face_lose.png"));
-    textures.push_back(loadTexture("files/images/face_win.png"));
-    textures.push_back(loadTexture("files/images/leaderboard.png"));
-    textures.push_back(loadTexture("files/images/mine.png"));
-    textures.push_back(loadTexture("files/images/pause.png"));
-    textures.push_back(loadTexture("files/images/play.png"));
-    textures.push_back(loadTexture("files/images/tile_hidden.png"));
-    textures.push_back(loadTexture("files/images/tile_revealed.png"));
-    return textures;
+// Plays a replay back as fast as possible without a window, checking the board against every keyframe.
+// With seekMs, jumps straight to that point via the keyframes and prints the board instead.
+int verifyReplay(const std::string& path, long long seekMs) {
+    ReplayReader reader(path);
+    Board board = Board({reader.getCols(), reader.getRows()}, reader.getMines(), reader.getSeed());
+    if (seekMs >= 0) {
+        reader.seek(seekMs, board);
+        printBoard(board);
+        return EXIT_SUCCESS;
+    }
+    ReplayEvent event{};
+    long long actions = 0;
+    long long keyframes = 0;
+    long long mismatches = 0;
+    long long endMs = 0;
+    while (reader.next(event)) {
+        if (event.type == ReplayEvent::keyframe) {
+            keyframes++;
+            if (!(board.saveState() == reader.getKeyframe())) {
+                mismatches++;
+                std::cerr << "Board differs from the keyframe at " << event.timeMs << " ms" << std::endl;
+            }
+            continue;
+        }
+        ReplayReader::apply(event, board);
+        actions++;
+        endMs = event.timeMs;
+    }
+    std::cout << actions << " actions over " << endMs << " ms, " << keyframes << " keyframes checked, "
+              << mismatches << " mismatched" << std::endl;
+    printBoard(board);
+    return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
-// Main game window
-void renderGameWindow(sf::RenderWindow& window, Board& board, TrayGui& gui) {
-
-    std::vector<sf::Texture> textures = loadTextures();
-    enum textureIndices {
-        flag, num1, num2, num3, num4, num5, num6, num7, num8, debug, digits, happy, lose, win, lb, mine,
-        pause, play, hidden, revealed
-    };
+// Plays games without a window and prints the totals. Game g uses seed + g.
+int runSimulation(int cols, int rows, int mines, long long games, const std::string& strategyName, int threads,
+                  std::uint64_t seed) {
+    std::unique_ptr<Strategy> probe = Strategy::create(strategyName);
+    if (!probe || cols <= 0 || rows <= 0 || mines < 0 || mines > cols * rows) {
+        std::cerr << "Unknown strategy or invalid board size" << std::endl;
+        return EXIT_FAILURE;
+    }
+    SimulationReport report = Simulator(cols, rows, mines, strategyName, threads).run(games, seed);
+    double gamesPerSecond = report.seconds > 0 ? static_cast<double>(report.games) / report.seconds : 0;
+    std::cout << report.games << " games of " << cols << "x" << rows << " with " << mines << " mines, strategy "
+              << strategyName << ", seeds from " << seed << ", " << report.threads << " threads" << std::endl
+              << "win rate " << 100.0 * static_cast<double>(report.wins) / static_cast<double>(report.games)
+              << "%, " << static_cast<double>(report.clicks) / static_cast<double>(report.games)
+              << " clicks per game" << std::endl
+              << gamesPerSecond << " games/s, " << gamesPerSecond / report.threads << " games/s per core" << std::endl;
+    return EXIT_SUCCESS;
+}
 
-    std::vector<sf::Texture> tileTextures = {textures[flag], textures[num1], textures[num2], textures[num3],
-                                             textures[num4], textures[num5], textures[num6], textures[num7],
-                                             textures[num8], textures[mine], textures[hidden], textures[revealed]};
+// One character per tile: '#' hidden, 'F' flagged, '*' mine, '.' or the count when revealed
+void printBoard(const Board& board) {
+    const TileGrid& grid = board.getGrid();
+    for (int row = 0; row < grid.getRows(); row++) {
+        std::string line;
+        for (int col = 0; col < grid.getCols(); col++) {
+            int index = grid.index(col, row);
+            if (grid.isFlagged(index) && !grid.isRevealed(index)) {
+                line += 'F';
+            } else if (!grid.isRevealed(index)) {
+                line += '#';
+            } else if (grid.isMine(index)) {
+                line += '*';
+            } else {
+                int count = grid.countMineNeighbors(index);
+                line += count == 0 ? '.' : static_cast<char>('0' + count);
+            }
+        }
+        std::cout << line << std::endl;
+    }
+    std::cout << "seed " << board.getSeed() << ", " << board.getRevealed() << " revealed, " << board.getFlags()
+              << " flagged" << (board.isGameOver() ? (board.isGameWon() ? ", won" : ", lost") : "") << std::endl;
+}
 
-    std::vector<sf::Texture> guiTextures = {textures[debug], textures[digits], textures[happy], textures[lose],
-                                            textures[win], textures[lb], textures[pause], textures[play]};
+// Replayed tray actions go through the tray so its timer and buttons follow along
+void applyReplayEvent(const ReplayEvent& event, Board& board, TrayGui& gui) {
+    switch (event.type) {
+        case ReplayEvent::pause:
+            gui.setPaused(true, board);
+            break;
+        case ReplayEvent::resume:
+            gui.setPaused(false, board);
+            break;
+        case ReplayEvent::reset:
+            if (gui.isLeaderboardOpen()) {
+                gui.closeLeaderboard(board);
+            }
+            gui.resetGame(board);
+            break;
+        default:
+            ReplayReader::apply(event, board);
+            break;
+    }
+}
 
-    bool lbCurrentlyOpen;
+// Main game window; with a replay, its actions drive the board instead of the mouse
+void renderGameWindow(sf::RenderWindow& window, Board& board, TrayGui& gui, const AssetRegistry& assets,
+                      ReplayReader* replay) {
+    BoardRenderer boardRenderer(assets);
+    BoardCamera camera(window.getSize(), TRAY_HEIGHT, board.getGrid());
+    // A middle-button drag pans the board
+    bool dragging = false;
+    sf::Vector2i dragPosition;
+    // Solver hints for debug mode, computed off the render thread
+    HintEngine hintEngine;
+    SolverResult hints;
+    bool hasHints = false;
+    // H toggles a mine probability heat map, also debug mode only
+    bool showHeatMap = false;
+    ProbabilityResult probabilities;
+    bool hasProbabilities = false;
+    std::uint64_t submittedRevision = ~std::uint64_t(0);
+    bool submittedHeatMap = false;
+    ReplayEvent replayEvent{};
+    bool hasReplayEvent = replay != nullptr && replay->next(replayEvent);
+    std::chrono::steady_clock::time_point replayStart = std::chrono::steady_clock::now();
+
+    // Only redraw when something visible changed: input, a game state change, or the timer's second
+    bool needsRedraw = true;
+    long long displayedSeconds = -1;
+    std::string displayedTitle = "Minesweeper";
     while (window.isOpen()) {
-        if (lbCurrentlyOpen) {
-            lbCurrentlyOpen = false;
-            continue;
-        }
         sf::Event event{};
-        if (board.isGameOver()) {
-            gui.setGameOver(true);
-            gui.setGameWon(board.isGameWon());
-        }
-        while (window.pollEvent(event)) {
+        // Block on input while nothing is ticking; otherwise input is still handled as it arrives
+        bool busy = hasReplayEvent || gui.needsPolling() || hintEngine.isBusy();
+        bool hasEvent = busy ? window.pollEvent(event) : window.waitEvent(event);
+        while (hasEvent) {
             // Close the window if closed by the OS
             if (event.type == sf::Event::Closed) {
                 window.close();
                 return;
             }
-            if (event.type == sf::Event::MouseButtonPressed && window.hasFocus()) {
+            // The OS may have discarded the window contents
+            if (event.type == sf::Event::GainedFocus || event.type == sf::Event::Resized) {
+                needsRedraw = true;
+            }
+            // Any click or Escape dismisses the leaderboard overlay, and does nothing else
+            if (gui.isLeaderboardOpen()) {
+                if (event.type == sf::Event::MouseButtonPressed ||
+                    (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)) {
+                    gui.closeLeaderboard(board);
+                    needsRedraw = true;
+                }
+                hasEvent = window.pollEvent(event);
+                continue;
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::H) {
+                showHeatMap = !showHeatMap;
+                needsRedraw = true;
+            }
+            if (handleCameraEvent(event, window, camera, dragging, dragPosition)) {
+                needsRedraw = true;
+            }
+            if (event.type == sf::Event::MouseButtonPressed && window.hasFocus() && replay == nullptr) {
+                needsRedraw = true;
                 bool isLeftMouseButton;
                 sf::Vector2i mousePosition = sf::Mouse::getPosition(window);
-                lbCurrentlyOpen = gui.click(window, mousePosition, tileTextures, board);
-                if (lbCurrentlyOpen) {
-                    // Flush event queue to remove stray left clicks from hitting the game window
-                    while (window.pollEvent(event)) {
-                        // polling event queue pops them, don't need to do anything here
-                    }
-                    break;
-                }
-                if (event.mouseButton.button == sf::Mouse::Left) {
+                gui.click(window, mousePosition, board);
+                // The tray covers the bottom of the board's view
+                if (camera.contains(mousePosition) && event.mouseButton.button == sf::Mouse::Left) {
                     isLeftMouseButton = true;
-                    if (!board.isGameOver() && !board.paused()) {
-                        board.click(window, mousePosition, isLeftMouseButton);
-                    }
+                    boardRenderer.click(window, camera.getView(), mousePosition, board, isLeftMouseButton);
                 }
-                if (event.mouseButton.button == sf::Mouse::Right) {
+                if (camera.contains(mousePosition) && event.mouseButton.button == sf::Mouse::Right) {
                     isLeftMouseButton = false;
-                    if (!board.isGameOver()) {
-                        board.click(window, mousePosition, isLeftMouseButton);
-                    }
+                    boardRenderer.click(window, camera.getView(), mousePosition, board, isLeftMouseButton);
                 }
             }
+            hasEvent = window.pollEvent(event);
+        }
+        // Apply every recorded action that is now due
+        if (hasReplayEvent) {
+            long long replayMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - replayStart).count();
+            while (hasReplayEvent && replayEvent.timeMs <= replayMs) {
+                applyReplayEvent(replayEvent, board, gui);
+                needsRedraw = true;
+                hasReplayEvent = replay->next(replayEvent);
+            }
+        }
+        // Re-solve whenever the board changes while hints are on, or the heat map is turned on; a newer
+        // board cancels an older solve. A finished game shows its mines as revealed, which the solver would
+        // read as numbers, and is never hinted anyway.
+        if (board.isDebugMode() && !board.isGameOver() &&
+            (board.getRevision() != submittedRevision || (showHeatMap && !submittedHeatMap))) {
+            submittedRevision = board.getRevision();
+            submittedHeatMap = showHeatMap;
+            hintEngine.submit(board, showHeatMap);
+        }
+        if (hintEngine.poll(hints)) {
+            hasHints = true;
+            needsRedraw = true;
+        }
+        if (hintEngine.pollProbabilities(probabilities)) {
+            hasProbabilities = true;
+            needsRedraw = true;
+        }
+        // A leaderboard load or save finished in the background
+        if (gui.leaderboardChanged()) {
+            needsRedraw = true;
+        }
+        if (board.isGameOver() && !gui.isGameOver()) {
+            gui.setGameOver(true);
+            gui.setGameWon(board.isGameWon());
+            needsRedraw = true;
+        }
+        long long elapsedSeconds = gui.getElapsedSeconds();
+        if (elapsedSeconds != displayedSeconds) {
+            displayedSeconds = elapsedSeconds;
+            needsRedraw = true;
+        }
+        // Debug mode shows the current game's seed, so a board can be reproduced
+        std::string title = windowTitle(board);
+        if (title != displayedTitle) {
+            window.setTitle(title);
+            displayedTitle = title;
+        }
+        if (needsRedraw) {
+            window.clear(sf::Color::White);
+            window.setView(camera.getView());
+            boardRenderer.render(window, board);
+            // Hints for an older board are never shown; the heat map already includes them
+            bool showOverlay = board.isDebugMode() && !board.paused() && !board.isGameOver();
+            if (showOverlay && showHeatMap && hasProbabilities && probabilities.revision == board.getRevision()) {
+                boardRenderer.renderProbabilities(window, board.getGrid(), probabilities);
+            } else if (showOverlay && hasHints && hints.revision == board.getRevision()) {
+                boardRenderer.renderHints(window, board.getGrid(), hints);
+            }
+            window.setView(window.getDefaultView());
+            gui.render(window, board.getMines(), board.getFlags());
+            window.display();
+            needsRedraw = false;
+        } else {
+            // SFML has no timed waitEvent, so nap briefly between polls while the timer runs
+            sf::sleep(sf::milliseconds(10));
         }
-        window.clear(sf::Color::White);
-        board.render(window, tileTextures);
-        gui.render(window, guiTextures, board.getMines(), board.getFlags());
-        window.display();
-        // Save on processing power so the user doesn't think the program is mining bitcoin
-        sf::sleep(sf::seconds(1.0f / 60));
     }
 }
 
-bool renderWelcomeWindow(sf::RenderWindow& window, std::string& name) {
-    // Font text
-    sf::Font font;
-    if (!font.loadFromFile("files/font.ttf")) {
-        throw file_read_exception("Failed to load font!");
+// Arrow keys or WASD pan four tiles, the wheel or +/- zoom, Home resets the view, and a middle-button drag pans.
+// Returns true if the view changed.
+bool handleCameraEvent(const sf::Event& event, const sf::RenderWindow& window, BoardCamera& camera, bool& dragging,
+                       sf::Vector2i& dragPosition) {
+    if (event.type == sf::Event::KeyPressed) {
+        sf::Keyboard::Key key = event.key.code;
+        float panX = key == sf::Keyboard::Left || key == sf::Keyboard::A ? -128.0f :
+                     (key == sf::Keyboard::Right || key == sf::Keyboard::D ? 128.0f : 0.0f);
+        float panY = key == sf::Keyboard::Up || key == sf::Keyboard::W ? -128.0f :
+                     (key == sf::Keyboard::Down || key == sf::Keyboard::S ? 128.0f : 0.0f);
+        if (panX != 0 || panY != 0) {
+            camera.pan(sf::Vector2f(panX, panY));
+            return true;
+        }
+        // Keyboard zoom keeps the middle of the board area still
+        sf::Vector2i middle(static_cast<int>(window.getSize().x / 2),
+                            static_cast<int>((window.getSize().y - TRAY_HEIGHT) / 2));
+        if (key == sf::Keyboard::Add || key == sf::Keyboard::Equal) {
+            camera.zoomAt(0.8f, middle, window);
+            return true;
+        }
+        if (key == sf::Keyboard::Subtract || key == sf::Keyboard::Dash) {
+            camera.zoomAt(1.25f, middle, window);
+            return true;
+        }
+        if (key == sf::Keyboard::Home) {
+            camera.reset();
+            return true;
+        }
+        return false;
+    }
+    if (event.type == sf::Event::MouseWheelScrolled && event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel) {
+        sf::Vector2i pixel(event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+        if (!camera.contains(pixel)) {
+            return false;
+        }
+        // Scrolling up zooms in on the pointer
+        camera.zoomAt(std::pow(0.8f, event.mouseWheelScroll.delta), pixel, window);
+        return true;
+    }
+    if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Middle) {
+        dragPosition = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+        dragging = camera.contains(dragPosition);
+        return false;
     }
+    if (event.type == sf::Event::MouseButtonReleased && event.mouseButton.button == sf::Mouse::Middle) {
+        dragging = false;
+        return false;
+    }
+    if (event.type == sf::Event::MouseMoved && dragging) {
+        sf::Vector2i position(event.mouseMove.x, event.mouseMove.y);
+        // The board follows the pointer, so the view moves the other way
+        camera.pan(sf::Vector2f(static_cast<float>(dragPosition.x - position.x),
+                                static_cast<float>(dragPosition.y - position.y)));
+        dragPosition = position;
+        return true;
+    }
+    return false;
+}
 
+// Endless mode: arrow keys or WASD scroll, N starts a new board. Chunks far off screen are compressed or dropped.
+void renderEndlessWindow(sf::RenderWindow& window, EndlessBoard& board, const AssetRegistry& assets) {
+    BoardRenderer boardRenderer(assets);
+    long long originCol = -static_cast<long long>(window.getSize().x / 64);
+    long long originRow = -static_cast<long long>(window.getSize().y / 64);
+    std::string displayedTitle;
+    bool needsRedraw = true;
+    while (window.isOpen()) {
+        sf::Event event{};
+        if (!window.waitEvent(event)) {
+            break;
+        }
+        do {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+                return;
+            }
+            if (event.type == sf::Event::GainedFocus || event.type == sf::Event::Resized) {
+                needsRedraw = true;
+            }
+            if (event.type == sf::Event::KeyPressed) {
+                // Four tiles per press
+                sf::Keyboard::Key key = event.key.code;
+                originCol += key == sf::Keyboard::Left || key == sf::Keyboard::A ? -4 :
+                             (key == sf::Keyboard::Right || key == sf::Keyboard::D ? 4 : 0);
+                originRow += key == sf::Keyboard::Up || key == sf::Keyboard::W ? -4 :
+                             (key == sf::Keyboard::Down || key == sf::Keyboard::S ? 4 : 0);
+                if (key == sf::Keyboard::N) {
+                    board.reset(board.getSeed() + 1);
+                }
+                needsRedraw = true;
+            }
+            if (event.type == sf::Event::MouseButtonPressed && window.hasFocus()) {
+                sf::Vector2f position = window.mapPixelToCoords(sf::Mouse::getPosition(window));
+                long long col = originCol + static_cast<long long>(std::floor(position.x / 32));
+                long long row = originRow + static_cast<long long>(std::floor(position.y / 32));
+                if (event.mouseButton.button == sf::Mouse::Left) {
+                    board.reveal(col, row);
+                } else if (event.mouseButton.button == sf::Mouse::Right) {
+                    board.toggleFlag(col, row);
+                }
+                needsRedraw = true;
+            }
+        } while (window.pollEvent(event));
+        if (!needsRedraw) {
+            continue;
+        }
+        board.focus(originCol, originRow, originCol + window.getSize().x / 32, originRow + window.getSize().y / 32);
+        std::string title = "Minesweeper - " + std::to_string(board.getRevealed()) + " revealed" +
+                            (board.isGameOver() ? ", game over (N for a new board)" : "");
+        if (title != displayedTitle) {
+            window.setTitle(title);
+            displayedTitle = title;
+        }
+        window.clear(sf::Color::White);
+        boardRenderer.renderEndless(window, board, originCol, originRow);
+        window.display();
+        needsRedraw = false;
+    }
+}
+
+bool renderWelcomeWindow(sf::RenderWindow& window, std::string& name, const sf::Font& font) {
     // Text fields
     sf::Text welcomeText = initializeWelcomeText(window, font);
     sf::Text nameEntryText = initializeNameEntryText(window, font);
     sf::Text nameEntryField = fillNameEntryField(window, font, "");
 
-    // Event loop
+    // Event loop; only wakes up and redraws when there is input
     while (window.isOpen()) {
+        // Draw window elements
+        window.clear(sf::Color::Blue);
+        window.draw(welcomeText);
+        window.draw(nameEntryText);
+        window.draw(nameEntryField);
+        window.display();
+
         sf::Event event{};
-        while (window.pollEvent(event)) {
+        if (!window.waitEvent(event)) {
+            break;
+        }
+        do {
             // Close the window if closed by the OS
             if (event.type == sf::Event::Closed) {
                 window.close();
@@ -205,20 +634,37 @@ bool renderWelcomeWindow(sf::RenderWindow& window, std::string& name) {
                 // Render the name
                 nameEntryField = fillNameEntryField(window, font, name);
             }
-        }
+        } while (window.pollEvent(event));
+    }
+    return true;
+}
 
-        // Draw window elements
-        window.clear(sf::Color::Blue);
-        window.draw(welcomeText);
-        window.draw(nameEntryText);
-        window.draw(nameEntryField);
-        window.display();
-        sf::sleep(sf::seconds(1.0f / 60));
+std::pair<int, int> windowTiles(const std::pair<int, int>& dimensions) {
+    return {std::min(dimensions.first, MAX_WINDOW_COLS), std::min(dimensions.second, MAX_WINDOW_ROWS)};
+}
+
+std::string windowTitle(const Board& board) {
+    if (!board.isDebugMode()) {
+        return "Minesweeper";
+    }
+    return "Minesweeper - seed " + std::to_string(board.getSeed());
+}
+
+// Accepts a base-10 unsigned 64-bit number such as a seed; false if there is none or it does not parse
+bool parseUnsigned(const std::string& text, std::uint64_t& value) {
+    if (text.find_first_of("0123456789") == std::string::npos) {
+        return false;
+    }
+    try {
+        value = std::stoull(text);
+    } catch (std::logic_error& e) {
+        return false;
     }
     return true;
 }
 
-std::vector<int> readConfig() {
+// Reads cols, rows and mines; an optional 4th line overrides seed
+std::vector<int> readConfig(std::uint64_t& seed) {
     // Open the config file
     std::ifstream configFile = std::ifstream("files/config.cfg");
     if (!configFile.good()) {
@@ -247,6 +693,14 @@ std::vector<int> readConfig() {
         throw file_read_exception("File config.cfg has invalid contents!");
     }
 
+    // Optional seed; a missing or blank line keeps the caller's seed
+    std::string seedString;
+    if (std::getline(configFile, seedString, '\n') &&
+        seedString.find_first_not_of(" \t\r") != std::string::npos && !parseUnsigned(seedString, seed)) {
+        configFile.close();
+        throw file_read_exception("File config.cfg has an invalid seed!");
+    }
+
     std::vector<int> vec = {colCount, rowCount, mineCount};
     configFile.close();
     return vec;
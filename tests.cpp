@@ -0,0 +1,491 @@
+#include <atomic> // Solver cancellation flag
+#include <cmath> // std::fabs, std::lgamma, std::exp for reference probabilities
+#include <cstdio> // Failure output, std::remove for the replay file
+#include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "EndlessBoard.h"
+#include "MineSampler.h"
+#include "ProbabilityEngine.h"
+#include "ReplayLog.h"
+#include "Rng.h"
+#include "Solver.h"
+
+// Regression tests for minesweeper_core. Each check prints what failed; the exit code is the verdict.
+// Usage: Minesweeper_tests (also run by ctest)
+
+namespace {
+    int failures = 0;
+
+    void check(bool condition, const std::string& what) {
+        if (!condition) {
+            std::printf("FAIL: %s\n", what.c_str());
+            failures++;
+        }
+    }
+
+    // A solver input from a row-major list of SolverInput::HIDDEN and revealed counts
+    SolverInput makeInput(int cols, int rows, int totalMines, const std::vector<int>& tiles) {
+        SolverInput input;
+        input.cols = cols;
+        input.rows = rows;
+        input.totalMines = totalMines;
+        input.revision = 0;
+        for (int tile: tiles) {
+            input.tiles.push_back(static_cast<std::int8_t>(tile));
+        }
+        return input;
+    }
+
+    // xoshiro256** seeded through splitmix64; the expected draws come from an independent implementation
+    void testRngStream() {
+        Rng rng(1);
+        check(rng.next() == 0xb3f2af6d0fc710c5ULL && rng.next() == 0x853b559647364ceaULL &&
+              rng.next() == 0x92f89756082a4514ULL, "rng: seed 1 gives the reference stream");
+        Rng same(7);
+        Rng again(7);
+        Rng other(8);
+        bool identical = true;
+        bool differs = false;
+        for (int i = 0; i < 1000; i++) {
+            int draw = same.uniform(-3, 9);
+            identical = identical && draw == again.uniform(-3, 9);
+            differs = differs || draw != other.uniform(-3, 9);
+            check(draw >= -3 && draw <= 9, "rng: uniform stays in range");
+        }
+        check(identical, "rng: a seed always gives the same draws");
+        check(differs, "rng: another seed gives other draws");
+    }
+
+    // Places count mines on a fresh cols x rows grid, clicking at safeIndex (-1 for no click)
+    TileGrid sampleMines(int cols, int rows, int count, int safeIndex, std::uint64_t seed) {
+        TileGrid grid(cols, rows);
+        MineSampler(seed).placeMines(grid, count, safeIndex);
+        return grid;
+    }
+
+    bool sameMines(const TileGrid& a, const TileGrid& b) {
+        for (int i = 0; i < a.size(); i++) {
+            if (a.isMine(i) != b.isMine(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Mines in the 3x3 neighborhood of a tile, itself included
+    int minesAround(const TileGrid& grid, int index) {
+        return grid.countMineNeighbors(index) + (grid.isMine(index) ? 1 : 0);
+    }
+
+    // Sparse boards draw mines; boards over half full start full and draw the safe tiles instead
+    void testMineSampler() {
+        const int densities[] = {10, 45, 50, 55, 80};
+        for (int density: densities) {
+            int count = 16 * 16 * density / 100;
+            for (std::uint64_t seed = 1; seed <= 50; seed++) {
+                int safeIndex = static_cast<int>(seed * 37 % 256);
+                std::string name = "sampler: " + std::to_string(density) + "% seed " + std::to_string(seed);
+                TileGrid grid = sampleMines(16, 16, count, safeIndex, seed);
+                check(grid.countMines() == count, name + " places the wrong number of mines");
+                check(minesAround(grid, safeIndex) == 0, name + " puts a mine next to the first click");
+                check(sameMines(grid, sampleMines(16, 16, count, safeIndex, seed)), name + " is not repeatable");
+            }
+        }
+        check(!sameMines(sampleMines(16, 16, 40, 0, 1), sampleMines(16, 16, 40, 0, 2)),
+              "sampler: different seeds give the same board");
+        // No room for a clear 3x3: only the clicked tile stays safe
+        TileGrid crowded = sampleMines(10, 10, 95, 55, 3);
+        check(crowded.countMines() == 95 && !crowded.isMine(55), "sampler: a crowded board keeps the click safe");
+        check(sampleMines(4, 4, 99, -1, 3).countMines() == 16, "sampler: too many mines fills the board");
+    }
+
+    // Subset rule: the left 1 sees two tiles, both also seen by the right 1, so the right 1's others are safe
+    void testSolverOneOne() {
+        const int H = SolverInput::HIDDEN;
+        SolverInput input = makeInput(4, 2, 3, {H, H, H, H,
+                                                1, 1, H, H});
+        Solver solver;
+        SolverResult result;
+        std::atomic<bool> cancelled(false);
+        check(solver.solve(input, result, cancelled), "1-1: solve completes");
+        check(result.safe.test(2) && result.safe.test(6), "1-1: tiles 2 and 6 are safe");
+        check(result.safe.count() == 2 && result.mines.count() == 0, "1-1: nothing else is decided");
+    }
+
+    // The 2 sees one tile more than the 1 beside it, so that tile is a mine; the right 1 then clears the middle
+    void testSolverOneTwo() {
+        const int H = SolverInput::HIDDEN;
+        SolverInput input = makeInput(3, 3, 2, {H, H, H,
+                                                1, 2, 1,
+                                                0, 0, 0});
+        Solver solver;
+        SolverResult result;
+        std::atomic<bool> cancelled(false);
+        check(solver.solve(input, result, cancelled), "1-2: solve completes");
+        check(result.mines.test(0) && result.mines.test(2) && result.safe.test(1), "1-2: mines at 0 and 2, 1 safe");
+    }
+
+    // Every placement of the input's mines over its hidden tiles that agrees with the revealed numbers:
+    // how many there are, and in how many each tile is a mine. Only for boards with a few hidden tiles.
+    long long enumerateLayouts(const SolverInput& input, std::vector<long long>& mineLayouts) {
+        std::vector<int> hidden;
+        for (int i = 0; i < static_cast<int>(input.tiles.size()); i++) {
+            if (input.tiles[i] == SolverInput::HIDDEN) {
+                hidden.push_back(i);
+            }
+        }
+        mineLayouts.assign(input.tiles.size(), 0);
+        long long layouts = 0;
+        std::vector<bool> isMine(input.tiles.size());
+        for (std::uint32_t mask = 0; mask < (std::uint32_t(1) << hidden.size()); mask++) {
+            int mines = 0;
+            for (size_t h = 0; h < hidden.size(); h++) {
+                isMine[hidden[h]] = (mask >> h & 1) != 0;
+                mines += isMine[hidden[h]] ? 1 : 0;
+            }
+            if (mines != input.totalMines) {
+                continue;
+            }
+            bool consistent = true;
+            for (int i = 0; i < static_cast<int>(input.tiles.size()) && consistent; i++) {
+                if (input.tiles[i] == SolverInput::HIDDEN) {
+                    continue;
+                }
+                int count = 0;
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        int col = i % input.cols + dx;
+                        int row = i / input.cols + dy;
+                        if (col >= 0 && col < input.cols && row >= 0 && row < input.rows &&
+                            isMine[row * input.cols + col]) {
+                            count++;
+                        }
+                    }
+                }
+                consistent = count == input.tiles[i];
+            }
+            if (!consistent) {
+                continue;
+            }
+            layouts++;
+            for (int tile: hidden) {
+                mineLayouts[tile] += isMine[tile] ? 1 : 0;
+            }
+        }
+        return layouts;
+    }
+
+    // A 5x4 game with 4 mines, opened in the middle and then at a few random safe tiles. Returns false if
+    // that won the game.
+    bool playSmallBoard(std::uint64_t seed, SolverInput& input) {
+        Board board(std::make_pair(5, 4), 4, seed);
+        board.reveal(2, 2);
+        Rng rng(seed);
+        const TileGrid& grid = board.getGrid();
+        for (int opened = rng.uniform(0, 2); opened > 0 && !board.isGameOver(); opened--) {
+            int index = rng.uniform(0, grid.size() - 1);
+            if (!grid.isMine(index)) {
+                board.reveal(grid.colOf(index), grid.rowOf(index));
+            }
+        }
+        input.capture(board);
+        return !board.isGameOver();
+    }
+
+    // Whatever the solver decides must hold in every layout that fits the revealed numbers
+    void testSolverSoundness() {
+        Solver solver;
+        SolverResult result;
+        std::atomic<bool> cancelled(false);
+        for (std::uint64_t seed = 1; seed <= 300; seed++) {
+            SolverInput input;
+            if (!playSmallBoard(seed, input)) {
+                continue;
+            }
+            std::vector<long long> mineLayouts;
+            long long layouts = enumerateLayouts(input, mineLayouts);
+            solver.solve(input, result, cancelled);
+            for (int i = 0; i < static_cast<int>(input.tiles.size()); i++) {
+                if (result.safe.test(i)) {
+                    check(mineLayouts[i] == 0, "soundness: seed " + std::to_string(seed) + " tile " +
+                                               std::to_string(i) + " marked safe but can be a mine");
+                }
+                if (result.mines.test(i)) {
+                    check(mineLayouts[i] == layouts, "soundness: seed " + std::to_string(seed) + " tile " +
+                                                     std::to_string(i) + " marked a mine but can be safe");
+                }
+            }
+        }
+    }
+
+    // Exact mine chances for boards too big for enumerateLayouts. Backtracks over the hidden tiles next
+    // to a number, pruning any constraint that can no longer be met, then weights each layout by the ways
+    // the remaining mines fit in the other hidden tiles.
+    class ReferenceChances {
+    private:
+        const SolverInput& input;
+        std::vector<int> frontier;
+        // Per frontier tile, the revealed numbers around it
+        std::vector<std::vector<int>> numbersAround;
+        // Per revealed tile, mines placed and frontier tiles still open around it
+        std::vector<int> placed;
+        std::vector<int> open;
+        std::vector<bool> isMine;
+        // By number of frontier mines: layouts, and layouts with a mine on each frontier tile
+        std::vector<double> layouts;
+        std::vector<std::vector<double>> tileMines;
+
+        void search(size_t next, int mines) {
+            if (next == frontier.size()) {
+                layouts[mines]++;
+                for (size_t f = 0; f < frontier.size(); f++) {
+                    tileMines[mines][f] += isMine[f] ? 1 : 0;
+                }
+                return;
+            }
+            for (int value = 0; value <= 1; value++) {
+                bool feasible = true;
+                for (int number: numbersAround[next]) {
+                    placed[number] += value;
+                    open[number]--;
+                    feasible = feasible && placed[number] <= input.tiles[number] &&
+                               placed[number] + open[number] >= input.tiles[number];
+                }
+                if (feasible) {
+                    isMine[next] = value == 1;
+                    search(next + 1, mines + value);
+                }
+                for (int number: numbersAround[next]) {
+                    placed[number] -= value;
+                    open[number]++;
+                }
+            }
+        }
+
+    public:
+        explicit ReferenceChances(const SolverInput& input) : input(input) {
+        }
+
+        // Fills chance for every tile, REVEALED for revealed ones
+        void compute(std::vector<double>& chance) {
+            int size = static_cast<int>(input.tiles.size());
+            placed.assign(static_cast<size_t>(size), 0);
+            open.assign(static_cast<size_t>(size), 0);
+            std::vector<bool> inFrontier(static_cast<size_t>(size), false);
+            int interior = 0;
+            for (int i = 0; i < size; i++) {
+                if (input.tiles[i] != SolverInput::HIDDEN) {
+                    continue;
+                }
+                std::vector<int> numbers;
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        int col = i % input.cols + dx;
+                        int row = i / input.cols + dy;
+                        int neighbor = row * input.cols + col;
+                        if (col >= 0 && col < input.cols && row >= 0 && row < input.rows &&
+                            input.tiles[neighbor] != SolverInput::HIDDEN) {
+                            numbers.push_back(neighbor);
+                            open[neighbor]++;
+                        }
+                    }
+                }
+                if (numbers.empty()) {
+                    interior++;
+                } else {
+                    inFrontier[i] = true;
+                    frontier.push_back(i);
+                    numbersAround.push_back(numbers);
+                }
+            }
+            isMine.assign(frontier.size(), false);
+            layouts.assign(frontier.size() + 1, 0);
+            tileMines.assign(frontier.size() + 1, std::vector<double>(frontier.size(), 0));
+            search(0, 0);
+
+            // Relative weight of each frontier mine count: its layouts times the interior placements
+            double total = 0;
+            double interiorMines = 0;
+            std::vector<double> weight(frontier.size() + 1, 0);
+            for (int k = 0; k <= static_cast<int>(frontier.size()); k++) {
+                int rest = input.totalMines - k;
+                if (layouts[k] == 0 || rest < 0 || rest > interior) {
+                    continue;
+                }
+                weight[k] = std::exp(std::lgamma(interior + 1.0) - std::lgamma(rest + 1.0) -
+                                     std::lgamma(interior - rest + 1.0));
+                total += weight[k] * layouts[k];
+                interiorMines += weight[k] * layouts[k] * rest;
+            }
+            chance.assign(static_cast<size_t>(size), ProbabilityResult::REVEALED);
+            for (int i = 0; i < size; i++) {
+                if (input.tiles[i] == SolverInput::HIDDEN && !inFrontier[i]) {
+                    chance[i] = interiorMines / total / interior;
+                }
+            }
+            for (size_t f = 0; f < frontier.size(); f++) {
+                double mines = 0;
+                for (size_t k = 0; k <= frontier.size(); k++) {
+                    mines += weight[k] * tileMines[k][f];
+                }
+                chance[frontier[f]] = mines / total;
+            }
+        }
+    };
+
+    // Small boards have small frontiers, so these take the exact path and should match to rounding
+    void testProbabilitiesExact() {
+        Solver solver;
+        SolverResult known;
+        ProbabilityEngine engine(1);
+        ProbabilityResult result;
+        std::atomic<bool> cancelled(false);
+        for (std::uint64_t seed = 1; seed <= 300; seed++) {
+            SolverInput input;
+            if (!playSmallBoard(seed, input)) {
+                continue;
+            }
+            std::vector<long long> mineLayouts;
+            long long layouts = enumerateLayouts(input, mineLayouts);
+            solver.solve(input, known, cancelled);
+            engine.estimate(input, known, result, seed, cancelled);
+            std::string board = "exact probabilities: seed " + std::to_string(seed);
+            check(result.exact, board + " was sampled");
+            for (int i = 0; i < static_cast<int>(input.tiles.size()); i++) {
+                if (input.tiles[i] == SolverInput::HIDDEN) {
+                    double expected = static_cast<double>(mineLayouts[i]) / static_cast<double>(layouts);
+                    check(std::fabs(result.mineChance[i] - expected) < 1e-4,
+                          board + " tile " + std::to_string(i) + " is off");
+                }
+            }
+        }
+    }
+
+    // Plays 16x16 games with 40 mines by revealing solver-safe tiles until it is stuck, and checks the
+    // positions whose frontier is too big to enumerate. Sampling is noisy, so a board passes if no tile
+    // is far off and the typical tile is close.
+    void testProbabilitiesSampled() {
+        Solver solver;
+        SolverResult known;
+        ProbabilityEngine engine(1);
+        ProbabilityResult result;
+        std::atomic<bool> cancelled(false);
+        int sampledBoards = 0;
+        for (std::uint64_t seed = 1; seed <= 1500; seed++) {
+            Board board(std::make_pair(16, 16), 40, seed);
+            board.reveal(8, 8);
+            const TileGrid& grid = board.getGrid();
+            SolverInput input;
+            bool stuck = false;
+            while (!board.isGameOver() && !stuck) {
+                input.capture(board);
+                solver.solve(input, known, cancelled);
+                stuck = true;
+                for (int i = 0; i < grid.size() && stuck; i++) {
+                    if (known.safe.test(i) && !grid.isRevealed(i)) {
+                        board.reveal(grid.colOf(i), grid.rowOf(i));
+                        stuck = false;
+                    }
+                }
+            }
+            if (board.isGameOver()) {
+                continue;
+            }
+            engine.estimate(input, known, result, seed, cancelled);
+            if (result.exact) {
+                continue;
+            }
+            sampledBoards++;
+            std::vector<double> expected;
+            ReferenceChances(input).compute(expected);
+            double worst = 0;
+            double total = 0;
+            int hidden = 0;
+            for (size_t i = 0; i < expected.size(); i++) {
+                if (expected[i] != ProbabilityResult::REVEALED) {
+                    double error = std::fabs(result.mineChance[i] - expected[i]);
+                    worst = error > worst ? error : worst;
+                    total += error;
+                    hidden++;
+                }
+            }
+            std::string name = "sampled probabilities: seed " + std::to_string(seed);
+            check(worst < 0.1, name + " has a tile off by " + std::to_string(worst));
+            check(total / hidden < 0.01, name + " is off by " + std::to_string(total / hidden) + " on average");
+        }
+        check(sampledBoards >= 5, "sampled probabilities: only " + std::to_string(sampledBoards) + " boards sampled");
+    }
+
+    // Records a game long enough for several keyframes, then plays the file back and checks that every
+    // keyframe and the final board match the game. The writer is gone before the file is read, so its
+    // queued writes must all have landed.
+    void testReplayRoundTrip() {
+        const std::string path = "replay_round_trip.msr";
+        Board played(std::make_pair(30, 16), 10, 7);
+        {
+            ReplayWriter writer;
+            writer.begin(path, played);
+            played.setRecorder(&writer);
+            // Flags before the first reveal always count as actions; some are toggled twice
+            for (int i = 0; i < 3 * ReplayWriter::KEYFRAME_INTERVAL; i++) {
+                played.toggleFlag((i * 7) % 30, i % 16);
+            }
+            played.setPaused(true);
+            played.setPaused(false);
+            for (int i = 0; i < 40 && !played.isGameOver(); i++) {
+                played.reveal((i * 11) % 30, (i * 3) % 16);
+            }
+            played.setRecorder(nullptr);
+        }
+        ReplayReader reader(path);
+        Board replayed(std::make_pair(reader.getCols(), reader.getRows()), reader.getMines(), reader.getSeed());
+        ReplayEvent event{};
+        int keyframes = 0;
+        while (reader.next(event)) {
+            if (event.type == ReplayEvent::keyframe) {
+                check(replayed.saveState() == reader.getKeyframe(),
+                      "replay round trip: keyframe " + std::to_string(keyframes) + " differs");
+                keyframes++;
+            } else {
+                ReplayReader::apply(event, replayed);
+            }
+        }
+        check(keyframes >= 2, "replay round trip: only " + std::to_string(keyframes) + " keyframes");
+        check(replayed.saveState() == played.saveState(), "replay round trip: final board differs");
+        std::remove(path.c_str());
+    }
+
+    // Revealing a flagged tile first does nothing, so the safe opening goes to the first real reveal
+    void testEndlessFlaggedFirstReveal() {
+        for (std::uint64_t seed = 1; seed <= 100; seed++) {
+            std::string name = "endless flagged first reveal: seed " + std::to_string(seed);
+            EndlessBoard board(0.4, seed);
+            board.toggleFlag(5, 5);
+            board.reveal(5, 5);
+            check(!board.isRevealed(5, 5) && board.isFlagged(5, 5), name + " revealed the flagged tile");
+            board.reveal(100, -40);
+            check(!board.isGameOver(), name + " lost on the first real reveal");
+            check(board.countMineNeighbors(100, -40) == 0, name + " has mines next to the first real reveal");
+        }
+    }
+}
+
+int main() {
+    testRngStream();
+    testMineSampler();
+    testSolverOneOne();
+    testSolverOneTwo();
+    testSolverSoundness();
+    testProbabilitiesExact();
+    testProbabilitiesSampled();
+    testReplayRoundTrip();
+    testEndlessFlaggedFirstReveal();
+    if (failures != 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    std::printf("All checks passed\n");
+    return EXIT_SUCCESS;
+}